@@ -19,7 +19,7 @@ fi
 
 # generate a temporary new checksums list
 if ! [ -e "sha1sums_new.txt" ] || ( [ -f "sha1sums_new.txt" ] && [ -r "sha1sums_new.txt" ] && [ -w "sha1sums_new.txt" ] ); then
-    find . -name *.pgm -exec sha1sum '{}' \; | sort --key=2 > sha1sums_new.txt
+    find . \( -name '*.pgm' -o -name '*.ppm' \) -exec sha1sum '{}' \; | sort --key=2 > sha1sums_new.txt
 else
     echo "${TESTS_DIR}/sha1sums_new.txt: exists but is not a regular, readable/writable file"
     echo "ABORTING"
@@ -1,4 +1,12 @@
+#pragma once
+
 #include <stdint.h>
+#include <sys/types.h>
+#include <cstring>
+
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
 
 #include "BlockWriter.h"
 
@@ -6,14 +14,29 @@
 namespace mdjpeg {
 
 /// \brief Implements BlockWriter for block-wise writing of input to output in 1:1 scale.
-class BasicBlockWriter : public BlockWriter {
+///
+/// Supports cropping (see BlockWriter::set_src_window), output is then
+/// written for the window of pixels only.
+///
+/// \note Defined entirely in the header and marked \c final so that it can be
+/// statically dispatched and inlined into the decoding loop (see
+/// JpegDecoder::luma_decode).
+class BasicBlockWriter final : public BlockWriter {
 
     public:
 
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
         /// \brief Performs initialization.
         ///
         /// \param dst            Raw pixel buffer for writing output to,
-        ///                       minimum size is `src_width_px * src_height_px`.
+        ///                       minimum size is `src_width_px * src_height_px`
+        ///                       (the size of the window if cropping) unless
+        ///                       set otherwise by set_dst_layout().
         /// \param src_width_px   Width of the region of interest expressed in pixels.
         /// \param src_height_px  Height of the region of interest expressed in pixels.
         ///
@@ -21,19 +44,151 @@ class BasicBlockWriter : public BlockWriter {
         /// every new region of interest and should not be called again until
         /// the last block of that region has been written to destination
         /// buffer.
-        void init(uint8_t* const dst, const uint16_t src_width_px, [[maybe_unused]] const uint16_t src_height_px) noexcept override;
+        void init(uint8_t* const dst, const uint16_t src_width_px, [[maybe_unused]] const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            init_dst(dst, m_src_window.width_px);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+
+            m_is_cropping = m_src_window.width_px != src_width_px || m_src_window.height_px != src_height_px;
+            m_is_streaming = static_cast<uint32_t>(m_src_window.width_px) * m_src_window.height_px >= STREAMING_THRESHOLD_PX;
+        }
 
         /// \brief Performs a single block write.
         ///
         /// \param src_block  Input block.
         ///
-        /// Each call performs an unbuffered write of all input block pixels to
-        /// destination buffer.
+        /// Each call performs an unbuffered write of all input block pixels
+        /// (within the window if cropping) to destination buffer.
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        void write(int (&src_block)[64]) noexcept override {
+
+            if (m_is_cropping) {
+
+                write_cropped(src_block);
+            }
+
+            else {
+
+                uint32_t offset = m_block_y * m_dst_pitch_px + m_block_x;
+                uint src_idx = 0;
+
+                for (uint row = 0; row < 8; ++row) {
+
+                    for (uint col = 0; col < 8; ++col) {
+
+                        m_dst[offset + col] = src_block[src_idx++];
+                    }
+
+                    offset += m_dst_pitch_px;
+                }
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+        /// \brief Performs a write of a whole band of 8 pixel rows.
+        ///
+        /// \param src_rows      Input band, 8 rows of `src_width_px` pixels each,
+        ///                      stored contiguously.
+        /// \param src_width_px  Width of the region of interest expressed in pixels.
+        ///
+        /// Each call copies the band (rows and columns within the window if
+        /// cropping) to destination buffer row by row. For
+        /// large outputs (see init()) the copy bypasses the cache by means of
+        /// non-temporal stores where the target supports them (SSE2).
         ///
-        /// \note Blocks from a particular region of interest are presumed
-        /// served in the order in which they appear in the entropy-coded
-        /// segment.
-        void write(int (&src_block)[64]) noexcept override;
+        /// \note Not to be mixed with write() within the same region of
+        /// interest.
+        void write_rows(const uint8_t* const src_rows, const uint16_t src_width_px) noexcept override {
+
+            // rows of the band within the window
+            const BlockSpan span = clip_block();
+
+            uint8_t* dst = m_dst + (m_block_y + span.row_begin - m_src_window.y_px) * m_dst_pitch_px;
+            const uint8_t* src = src_rows + span.row_begin * src_width_px + m_src_window.x_px;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                copy_row(dst, src, m_src_window.width_px);
+                dst += m_dst_pitch_px;
+                src += src_width_px;
+            }
+
+            #ifdef __SSE2__
+                if (m_is_streaming) {
+
+                    // make non-temporal stores globally visible before returning
+                    _mm_sfence();
+                }
+            #endif
+
+            m_block_y += 8;
+        }
+
+    private:
+
+        // output size in pixels from which on bands are written using non-temporal stores
+        static constexpr uint32_t STREAMING_THRESHOLD_PX = 256 * 1024;
+
+        bool m_is_cropping {false};
+        bool m_is_streaming {false};
+
+        // writes pixels of the current block within the window
+        void write_cropped(const int (&src_block)[64]) noexcept {
+
+            const BlockSpan span = clip_block();
+
+            if (span.is_empty()) {
+
+                return;
+            }
+
+            uint8_t* dst = m_dst + (m_block_y + span.row_begin - m_src_window.y_px) * m_dst_pitch_px
+                                 + (m_block_x + span.col_begin - m_src_window.x_px);
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                for (uint col = span.col_begin; col < span.col_end; ++col) {
+
+                    dst[col - span.col_begin] = src_block[row * 8 + col];
+                }
+
+                dst += m_dst_pitch_px;
+            }
+        }
+
+        void copy_row(uint8_t* dst, const uint8_t* src, uint16_t width_px) const noexcept {
+
+            #ifdef __SSE2__
+                if (m_is_streaming) {
+
+                    // scalar head up to the first 16-byte aligned dst address
+                    while (width_px && reinterpret_cast<uintptr_t>(dst) % 16) {
+
+                        *dst++ = *src++;
+                        --width_px;
+                    }
+
+                    for (; width_px >= 16; width_px -= 16, dst += 16, src += 16) {
+
+                        _mm_stream_si128(reinterpret_cast<__m128i*>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+                    }
+                }
+            #endif
+
+            std::memcpy(dst, src, width_px);
+        }
 };
 
 }  // namespace mdjpeg
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <sys/types.h>
 #include <cmath>
+#include <algorithm>
 
 
 namespace mdjpeg {
@@ -35,6 +36,92 @@ class BlockWriter {
         /// - (re)set initial conditions relevant to their task.
         virtual void init(uint8_t* dst, uint16_t src_width_px, [[maybe_unused]] uint16_t src_height_px) noexcept = 0;
 
+        /// \brief Sets the layout of destination buffer for all subsequent regions of interest.
+        ///
+        /// \param dst_pitch_px  Distance between starts of consecutive destination
+        ///                      rows expressed in pixels, 0 for tightly packed output.
+        /// \param dst_x_px      X-coordinate of the output origin within destination buffer.
+        /// \param dst_y_px      Y-coordinate of the output origin within destination buffer.
+        ///
+        /// Allows writing the output directly into a larger canvas (e.g. a
+        /// mosaic or a padded frame) instead of into a buffer of its own. Takes
+        /// effect on the next call to init(). Non-zero pitch must be no less
+        /// than `dst_x_px` plus the width of the output produced by the
+        /// particular implementation.
+        ///
+        /// \note Implementations that produce output other than a raster image
+        /// of pixels may ignore the layout. Their documentation says so.
+        void set_dst_layout(const uint32_t dst_pitch_px, const uint16_t dst_x_px = 0, const uint16_t dst_y_px = 0) noexcept {
+
+            m_dst_layout.pitch_px = dst_pitch_px;
+            m_dst_layout.x_px = dst_x_px;
+            m_dst_layout.y_px = dst_y_px;
+        }
+
+        /// \brief Crops the next region of interest to a window of pixels.
+        ///
+        /// \param src_x_px       X-coordinate of the window within the region of
+        ///                       interest, less than 8.
+        /// \param src_y_px       Y-coordinate of the window within the region of
+        ///                       interest, less than 8.
+        /// \param src_width_px   Width of the window expressed in pixels.
+        /// \param src_height_px  Height of the window expressed in pixels.
+        ///
+        /// Called by JpegDecoder::luma_decode_px before init() with the
+        /// pixel-accurate region of interest relative to the blocks enclosing
+        /// it. Takes effect on the next call to init() and applies to that
+        /// region of interest only. Implementations that support cropping
+        /// discard pixels outside the window at write time and produce output
+        /// for the window alone, see supports_cropping(). Others produce output
+        /// for all pixels of the blocks served.
+        void set_src_window(const uint8_t src_x_px, const uint8_t src_y_px, const uint16_t src_width_px, const uint16_t src_height_px) noexcept {
+
+            m_pending_src_window = {src_x_px, src_y_px, src_width_px, src_height_px};
+        }
+
+        /// \brief Limits the window of the next region of interest to its top left pixels.
+        ///
+        /// \param src_width_px   Count of leftmost pixel columns of the region
+        ///                       of interest to keep.
+        /// \param src_height_px  Count of topmost pixel rows of the region of
+        ///                       interest to keep.
+        ///
+        /// Called by JpegDecoder before init() for regions of interest
+        /// including partial blocks on the right or bottom edge of the frame,
+        /// so that padding pixels of those blocks are cropped. Narrows the
+        /// window set by set_src_window(), if any, to fit. Otherwise sets the
+        /// window to the given top left pixels. Same as set_src_window(), it
+        /// takes effect only with writers that support cropping. Writers that
+        /// do not keep the padding pixels as trailing columns and rows of
+        /// their output.
+        void limit_src_window(const uint16_t src_width_px, const uint16_t src_height_px) noexcept {
+
+            if (!m_pending_src_window.width_px) {
+
+                m_pending_src_window = {0, 0, src_width_px, src_height_px};
+                return;
+            }
+
+            Window& window = m_pending_src_window;
+
+            window.width_px = std::min<uint16_t>(window.width_px, src_width_px - window.x_px);
+            window.height_px = std::min<uint16_t>(window.height_px, src_height_px - window.y_px);
+        }
+
+        /// \brief Queries whether the implementation supports cropping.
+        ///
+        /// \retval  true if the window set by set_src_window() or
+        ///          limit_src_window() is taken into account by init().
+        /// \retval  false if output is produced for all pixels of the blocks
+        ///          served (default).
+        ///
+        /// Implementations that support cropping override this function.
+        /// JpegDecoder::luma_decode_px refuses writers that do not.
+        virtual bool supports_cropping() const noexcept {
+
+            return false;
+        }
+
         /// \brief Dispatches a single block write.
         ///
         /// \param src_block  Input block.
@@ -44,19 +131,166 @@ class BlockWriter {
         /// destination.
         ///
         /// \note
-        /// - Blocks from a particular region of interest are presumed served in
-        ///   the order in which they appear in the entropy-coded segment.
+        /// - Blocks are presumed served in raster order within the region of
+        ///   interest.
         /// - It is not required for the writes to be unbuffered providing that
         ///   all expected output is written to the destination by the time the
         ///   function finishes with its last input block.
         virtual void write(int (&src_block)[64]) noexcept = 0;
 
+        /// \brief Dispatches a write of a whole band of 8 pixel rows.
+        ///
+        /// \param src_rows      Input band, 8 rows of `src_width_px` pixels each,
+        ///                      stored contiguously.
+        /// \param src_width_px  Width of the region of interest expressed in pixels.
+        ///
+        /// Implementations that benefit from row-wise access to their input
+        /// (e.g. for wide or streaming stores) should override this function.
+        /// The default implementation is an adapter that slices the band back
+        /// into blocks and feeds them to write() in the order they appear in
+        /// the band, so implementations that only provide write() still work.
+        ///
+        /// \note Bands from a particular region of interest are presumed served
+        /// top to bottom, each band spanning the entire region's width.
+        virtual void write_rows(const uint8_t* const src_rows, const uint16_t src_width_px) noexcept {
+
+            int block[64];
+
+            for (uint16_t block_x = 0; block_x < src_width_px; block_x += 8) {
+
+                const uint8_t* src = src_rows + block_x;
+                uint dst_idx = 0;
+
+                for (uint row = 0; row < 8; ++row) {
+
+                    for (uint col = 0; col < 8; ++col) {
+
+                        block[dst_idx++] = src[col];
+                    }
+
+                    src += src_width_px;
+                }
+
+                write(block);
+            }
+        }
+
     protected:
 
+        /// \brief Window of pixels within the region of interest (see set_src_window()).
+        struct Window {
+            uint16_t x_px {};
+            uint16_t y_px {};
+            uint16_t width_px {};
+            uint16_t height_px {};
+        };
+
+        /// \brief Columns and rows of a block, both ranges half-open.
+        struct BlockSpan {
+            uint8_t col_begin {};
+            uint8_t col_end {};
+            uint8_t row_begin {};
+            uint8_t row_end {};
+
+            /// \brief Checks whether the span covers no pixels at all.
+            bool is_empty() const noexcept {
+
+                return col_begin == col_end || row_begin == row_end;
+            }
+
+            /// \brief Checks whether the span covers the whole block.
+            bool is_full() const noexcept {
+
+                return col_begin == 0 && col_end == 8 && row_begin == 0 && row_end == 8;
+            }
+        };
+
         uint8_t* m_dst {nullptr};
+        uint32_t m_dst_pitch_px {};
         uint16_t m_src_width_px {};
         uint16_t m_block_x {};
         uint16_t m_block_y {};
+
+        /// \brief Registers destination according to its layout (see set_dst_layout()).
+        ///
+        /// \param dst           Raw pixel buffer as passed to init().
+        /// \param dst_width_px  Width of the output produced by the particular implementation.
+        /// \param px_size       Size of output pixels in bytes.
+        ///
+        /// Sets \c m_dst to the output origin and \c m_dst_pitch_px to the
+        /// effective pitch (still in pixels). Meant to be called from within
+        /// init().
+        void init_dst(uint8_t* const dst, const uint16_t dst_width_px, const uint8_t px_size = 1) noexcept {
+
+            m_dst_pitch_px = m_dst_layout.pitch_px ? m_dst_layout.pitch_px : dst_width_px;
+            m_dst = dst + (m_dst_layout.y_px * m_dst_pitch_px + m_dst_layout.x_px) * px_size;
+        }
+
+        /// \brief Registers the window of pixels to produce output for (see set_src_window()).
+        ///
+        /// \param src_width_px   Width of the region of interest as passed to init().
+        /// \param src_height_px  Height of the region of interest as passed to init().
+        ///
+        /// Sets \c m_src_window to the pending window if any, otherwise to the
+        /// whole region of interest, and clears the pending window. Meant to be
+        /// called from within init() by implementations that support cropping.
+        void init_src_window(const uint16_t src_width_px, const uint16_t src_height_px) noexcept {
+
+            m_src_window = m_pending_src_window.width_px ? m_pending_src_window : Window {0, 0, src_width_px, src_height_px};
+            m_pending_src_window = {};
+        }
+
+        /// \brief Extends \c m_src_window outwards to bounds that are multiples of \c alignment.
+        ///
+        /// \param alignment  Alignment in pixels, a divisor of 8.
+        ///
+        /// Meant to be called from within init() right after init_src_window()
+        /// by implementations that process pixels in groups (e.g. 2x2 chroma
+        /// cells). The window then gains up to `alignment - 1` columns and rows
+        /// of pixels on each side, still within the region of interest since
+        /// its dimensions are multiples of 8.
+        void align_src_window(const uint8_t alignment) noexcept {
+
+            const uint16_t mask = ~(alignment - 1u);
+            const uint16_t x2_px = (m_src_window.x_px + m_src_window.width_px + alignment - 1) & mask;
+            const uint16_t y2_px = (m_src_window.y_px + m_src_window.height_px + alignment - 1) & mask;
+
+            m_src_window.x_px &= mask;
+            m_src_window.y_px &= mask;
+            m_src_window.width_px = x2_px - m_src_window.x_px;
+            m_src_window.height_px = y2_px - m_src_window.y_px;
+        }
+
+        /// \brief Computes which pixels of the current block lie within \c m_src_window.
+        ///
+        /// \return  Span of the block at (\c m_block_x, \c m_block_y), empty if
+        ///          the block lies outside the window.
+        BlockSpan clip_block() const noexcept {
+
+            const int col_begin = m_src_window.x_px - m_block_x;
+            const int row_begin = m_src_window.y_px - m_block_y;
+
+            return {clamp_to_block(col_begin), clamp_to_block(col_begin + m_src_window.width_px),
+                    clamp_to_block(row_begin), clamp_to_block(row_begin + m_src_window.height_px)};
+        }
+
+        Window m_src_window {};
+
+    private:
+
+        Window m_pending_src_window {};
+
+        // clamps block-relative coordinate to [0, 8]
+        static uint8_t clamp_to_block(const int coord) noexcept {
+
+            return coord < 0 ? 0 : (coord > 8 ? 8 : coord);
+        }
+
+        struct {
+            uint32_t pitch_px {};
+            uint16_t x_px {};
+            uint16_t y_px {};
+        } m_dst_layout {};
 };
 
 }  // namespace mdjpeg
@@ -74,6 +74,18 @@ struct BoundingBox {
             return bottomright_Y - topleft_Y;
         }
 
+        /// \brief Checks if a point lies within bounding box.
+        ///
+        /// \param x  X-coordinate of the point.
+        /// \param y  Y-coordinate of the point.
+        ///
+        /// Top-left corner coordinates are inclusive, bottom-right corner
+        /// coordinates are exclusive.
+        bool contains(const uint16_t x, const uint16_t y) const noexcept {
+
+            return x >= topleft_X && x < bottomright_X && y >= topleft_Y && y < bottomright_Y;
+        }
+
         /// \brief Expands bounding box to tightly fit around another.
         ///
         /// \param other  The box to merge with / expand over.
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Abstract base class for block writers of color output.
+///
+/// Extends BlockWriter by a write() overload taking blocks of all three
+/// Y'CbCr channels, served by JpegDecoder::color_decode. Chroma blocks are
+/// upsampled to luma resolution beforehand, so all three blocks cover the
+/// same 8x8 pixels. The luma-only write() inherited from BlockWriter remains
+/// to be implemented, so that color writers can also serve luma-only
+/// decompression modes (e.g. by producing grayscale output).
+class ColorBlockWriter : public BlockWriter {
+
+    protected:
+
+        ~ColorBlockWriter() = default;
+
+    public:
+
+        using BlockWriter::write;
+
+        /// \brief Dispatches a single write of a block of color pixels.
+        ///
+        /// \param y_block   Input luma block.
+        /// \param cb_block  Input Cb block, upsampled to luma resolution.
+        /// \param cr_block  Input Cr block, upsampled to luma resolution.
+        ///
+        /// Every implementation should use this function's override to
+        /// iteratively perform the task of writing input blocks to their output
+        /// destination.
+        ///
+        /// \note Blocks are presumed served in raster order of their luma blocks
+        /// within the region of interest.
+        virtual void write(int (&y_block)[64], int (&cb_block)[64], int (&cr_block)[64]) noexcept = 0;
+};
+
+}  // namespace mdjpeg
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Implements BlockWriter for feeding the same input into multiple BlockWriters.
+///
+/// \tparam MAX_CHILDREN  Maximum count of attached child writers.
+///
+/// Forwards every input block (or band of rows) to each of the attached child
+/// writers in order of their attachment. Allows a single decompression pass
+/// (entropy decoding, dequantization, %IDCT) to serve e.g. a full scale crop,
+/// a thumbnail and luma statistics of the same region of interest at once.
+///
+/// \note Each child writer writes to its own destination registered along
+/// with it by attach(). The destination passed to init() is ignored and may be
+/// \c nullptr. Destination layouts, if any, must be set on child writers
+/// themselves.
+template <uint8_t MAX_CHILDREN>
+class CompositeBlockWriter final : public BlockWriter {
+
+    public:
+
+        /// \brief Attaches a child writer.
+        ///
+        /// \param writer  Child writer, must outlive its attachment.
+        /// \param dst     Raw pixel buffer for the child writer to write its
+        ///                output to, min size depending on particular writer.
+        /// \retval        true on success.
+        /// \retval        false if \c MAX_CHILDREN writers are already attached.
+        ///
+        /// Takes effect on the next call to init().
+        bool attach(BlockWriter& writer, uint8_t* const dst) noexcept {
+
+            if (m_children_count == MAX_CHILDREN) {
+
+                return false;
+            }
+
+            m_children[m_children_count].writer = &writer;
+            m_children[m_children_count].dst = dst;
+            ++m_children_count;
+
+            return true;
+        }
+
+        /// \brief Detaches all child writers.
+        void detach_all() noexcept {
+
+            m_children_count = 0;
+        }
+
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        ///
+        /// \retval  true if all attached child writers support cropping.
+        /// \retval  false otherwise.
+        bool supports_cropping() const noexcept override {
+
+            for (uint i = 0; i < m_children_count; ++i) {
+
+                if (!m_children[i].writer->supports_cropping()) {
+
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// \brief Performs initialization of all child writers.
+        ///
+        /// \param dst            Ignored.
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// Calls BlockWriter::init of every child writer with its own
+        /// destination and the region of interest dimensions. The window set
+        /// by BlockWriter::set_src_window, if any, is passed on beforehand to
+        /// every child writer that supports cropping.
+        void init([[maybe_unused]] uint8_t* const dst, const uint16_t src_width_px, const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            m_src_width_px = src_width_px;
+
+            for (uint i = 0; i < m_children_count; ++i) {
+
+                if (m_children[i].writer->supports_cropping()) {
+
+                    m_children[i].writer->set_src_window(m_src_window.x_px, m_src_window.y_px, m_src_window.width_px, m_src_window.height_px);
+                }
+
+                m_children[i].writer->init(m_children[i].dst, src_width_px, src_height_px);
+            }
+        }
+
+        /// \brief Forwards a single block to all child writers.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// Every child writer but the last receives its own copy of the input
+        /// block so that none of them can affect the input of the others.
+        void write(int (&src_block)[64]) noexcept override {
+
+            if (!m_children_count) {
+
+                return;
+            }
+
+            int block_copy[64];
+
+            for (uint i = 0; i + 1 < m_children_count; ++i) {
+
+                for (uint j = 0; j < 64; ++j) {
+
+                    block_copy[j] = src_block[j];
+                }
+
+                m_children[i].writer->write(block_copy);
+            }
+
+            m_children[m_children_count - 1].writer->write(src_block);
+        }
+
+        /// \brief Forwards a band of 8 pixel rows to all child writers.
+        ///
+        /// \param src_rows      Input band, 8 rows of `src_width_px` pixels each,
+        ///                      stored contiguously.
+        /// \param src_width_px  Width of the region of interest expressed in pixels.
+        void write_rows(const uint8_t* const src_rows, const uint16_t src_width_px) noexcept override {
+
+            for (uint i = 0; i < m_children_count; ++i) {
+
+                m_children[i].writer->write_rows(src_rows, src_width_px);
+            }
+        }
+
+    private:
+
+        struct Child {
+            BlockWriter* writer {nullptr};
+            uint8_t* dst {nullptr};
+        };
+
+        Child m_children[MAX_CHILDREN] {};
+        uint8_t m_children_count {};
+};
+
+}  // namespace mdjpeg
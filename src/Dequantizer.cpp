@@ -1,5 +1,7 @@
 #include "Dequantizer.h"
 
+#include <algorithm>
+
 #include "JpegReader.h"
 
 
@@ -18,18 +20,30 @@ uint8_t Dequantizer::set_qtable(JpegReader& reader, const uint16_t max_read_leng
         return 0;
     }
 
-    // store only 8-bit luma quantization table pointer
-    if (table_id == 0) {
+    if (table_id >= TABLES_COUNT) {
 
-        if (precision == 1) {
+        return 0;
+    }
 
-            m_qtable = reader.tell_ptr();
-        }
+    // store only 8-bit quantization tables
+    if (precision == 1) {
 
-        else {
+        const uint8_t* const qtable = reader.tell_ptr();
 
-            return 0;
-        }
+        std::copy(qtable, qtable + 64, m_qtables_buff[table_id]);
+        m_qtables[table_id] = m_qtables_buff[table_id];
+    }
+
+    // 16-bit luma quantization table is not supported
+    else if (table_id == 0) {
+
+        return 0;
+    }
+
+    // 16-bit chroma quantization tables render color decoding unsupported
+    else {
+
+        m_qtables[table_id] = nullptr;
     }
 
     reader.seek(table_size);
@@ -37,15 +51,17 @@ uint8_t Dequantizer::set_qtable(JpegReader& reader, const uint16_t max_read_leng
     return 1 + table_size;
 }
 
-void Dequantizer::transform(int (&block)[64]) const noexcept {
+void Dequantizer::transform(int (&block)[64], const uint8_t table_id) const noexcept {
+
+    const uint8_t* const qtable = m_qtables[table_id];
 
     for (uint i = 0; i < 64; ++i) {
 
-        block[i] *= m_qtable[i];
+        block[i] *= qtable[i];
     }
 }
 
-void Dequantizer::transform(int& dc_coeff) const noexcept {
+void Dequantizer::transform(int& dc_coeff, const uint8_t table_id) const noexcept {
 
-    dc_coeff *= m_qtable[0];
+    dc_coeff *= m_qtables[table_id][0];
 }
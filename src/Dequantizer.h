@@ -12,7 +12,8 @@ class JpegReader;
 /// \brief Class for dequantizing JFIF DCT coefficients.
 ///
 /// Dequantizes (actually, denormalizes since quantization step is lossy and
-/// irreversible) quantized DCT coefficients.
+/// irreversible) quantized DCT coefficients. Keeps copies of up to 4
+/// quantization tables, addressed by their IDs, table 0 being the luma one.
 class Dequantizer {
 
     public:
@@ -20,29 +21,47 @@ class Dequantizer {
         /// \brief Populates quantization table from \c reader buffer starting at cursor.
         ///
         /// \return  Number of bytes read through from the JFIF segment.
+        ///
+        /// The table is copied, so it does not depend on the JFIF data once set.
         uint8_t set_qtable(JpegReader& reader, uint16_t max_read_length) noexcept;
 
         /// \brief Checks if the quantization table is validly set.
-        bool is_set() const noexcept {
+        ///
+        /// \param table_id  ID of the table, 0 (luma) by default.
+        bool is_set(const uint8_t table_id = 0) const noexcept {
 
-            return m_qtable;
+            return table_id < TABLES_COUNT && m_qtables[table_id];
         }
 
-        /// \brief Invalidates the quantization table.
+        /// \brief Invalidates all quantization tables.
         void clear() noexcept {
 
-            m_qtable = nullptr;
+            for (uint i = 0; i < TABLES_COUNT; ++i) {
+
+                m_qtables[i] = nullptr;
+            }
         }
 
         /// \brief Dequantizes a block of DCT coefficients (in place).
-        void transform(int (&block)[64]) const noexcept;
+        ///
+        /// \param block     Block of DCT coefficients.
+        /// \param table_id  ID of the table to use, must be set, 0 (luma) by default.
+        void transform(int (&block)[64], uint8_t table_id = 0) const noexcept;
 
         /// \brief Dequantizes a single (DC) DCT coefficient (in place).
-        void transform(int& dc_coeff) const noexcept;
+        ///
+        /// \param dc_coeff  DC DCT coefficient.
+        /// \param table_id  ID of the table to use, must be set, 0 (luma) by default.
+        void transform(int& dc_coeff, uint8_t table_id = 0) const noexcept;
 
     private:
 
-        const uint8_t* m_qtable {nullptr};
+        static constexpr uint8_t TABLES_COUNT = 4;
+
+        // set tables, pointing into `m_qtables_buff`
+        const uint8_t* m_qtables[TABLES_COUNT] {};
+
+        uint8_t m_qtables_buff[TABLES_COUNT][64] {};
 };
 
 }  // namespace mdjpeg
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <stdint.h>
 #include <sys/types.h>
 
@@ -8,29 +10,63 @@
 
 namespace mdjpeg {
 
+/// \brief Default output policy of DownscalingBlockWriter, writes 8-bit pixels.
+///
+/// An output policy receives every downscaled output value exactly once, as
+/// soon as all of its contributing input pixels have been accumulated. Any
+/// class providing a member function with the same signature as write() can
+/// be used as a policy.
+struct PixelOutput {
+
+    /// \brief Writes a single output value as a rounded and saturated pixel.
+    ///
+    /// \param dst           Destination origin as registered by DownscalingBlockWriter::init.
+    /// \param dst_pitch_px  Effective destination pitch expressed in pixels.
+    /// \param x_px          X-coordinate of the output pixel.
+    /// \param y_px          Y-coordinate of the output pixel.
+    /// \param value         Average of contributing input pixels.
+    void write(uint8_t* const dst, const uint32_t dst_pitch_px, const uint16_t x_px, const uint16_t y_px, const float value) const noexcept {
+
+        const uint dst_val = std::lround(value);
+        dst[y_px * dst_pitch_px + x_px] = dst_val <= 255 ? dst_val : 255;
+    }
+};
+
 /// \brief Implements BlockWriter for block-wise writing with downscaling.
 ///
 /// \tparam DST_WIDTH_PX   Width of the destination image in pixels.
 /// \tparam DST_HEIGHT_PX  Height of the destination image in pixels.
+/// \tparam Output         Output policy, see PixelOutput.
+///
+/// Supports cropping (see BlockWriter::set_src_window), output is then
+/// computed from the window of pixels only.
 ///
 /// \note Output dimensions defined by these parameters need not be multiples of
 /// 8 pixels. They must be greater than zero and no greater than corresponding
-/// dimensions of source region of interest (see parameters to init()).
-template <uint16_t DST_WIDTH_PX, uint16_t DST_HEIGHT_PX>
+/// dimensions of source region of interest (see parameters to init()), or of
+/// the window if cropping.
+template <uint16_t DST_WIDTH_PX, uint16_t DST_HEIGHT_PX, class Output = PixelOutput>
 // DST_HEIGHT_PX could have been passed as a regular parameter to `init`
 // but is kept bundled here instead because of its close relation to
 // DST_WIDTH_PX and no relation to `init` parameters. For all intended
 // purposes the two template parameters are interdependent and no additional
 // template instantiation occurs in normal use just because of the extra
 // parameter.
-class DownscalingBlockWriter : public BlockWriter {
+class DownscalingBlockWriter final : public BlockWriter {
 
     public:
 
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
         /// \brief Performs initialization.
         ///
         /// \param dst            Raw pixel buffer for writing output to,
-        ///                       minimum size is `DST_WIDTH_PX * DST_HEIGHT_PX`.
+        ///                       minimum size is `DST_WIDTH_PX * DST_HEIGHT_PX`
+        ///                       unless set otherwise by set_dst_layout().
         /// \param src_width_px   Width of the region of interest expressed in pixels.
         /// \param src_height_px  Height of the region of interest expressed in pixels.
         ///
@@ -43,18 +79,19 @@ class DownscalingBlockWriter : public BlockWriter {
         /// corresponding destination dimensions. Otherwise it would not be a
         /// task of downscaling but rather upscaling. Additionally, since
         /// writing is done in blocks, both source dimensions must be multiples
-        /// of 8 pixels.
+        /// of 8 pixels. The dimensions of the window, if cropping, need not.
         // `[[maybe_unused]]` is added only to satisfy Doxygen
         // (in fact, the parameter is always used)
         void init(uint8_t* const dst, const uint16_t src_width_px, [[maybe_unused]] const uint16_t src_height_px) noexcept override {
 
-            m_dst = dst;
+            init_src_window(src_width_px, src_height_px);
+            init_dst(dst, DST_WIDTH_PX);
             m_src_width_px = src_width_px;
-            m_horiz_scaling_factor = static_cast<float>(DST_WIDTH_PX) / src_width_px;
-            m_vert_scaling_factor = static_cast<float>(DST_HEIGHT_PX) / src_height_px;
+            m_horiz_scaling_factor = static_cast<float>(DST_WIDTH_PX) / m_src_window.width_px;
+            m_vert_scaling_factor = static_cast<float>(DST_HEIGHT_PX) / m_src_window.height_px;
             m_val_norm_factor = m_horiz_scaling_factor * m_vert_scaling_factor;
-            m_epsilon_horiz = 1.0f / (src_width_px + 1);
-            m_epsilon_vert = 1.0f / (src_height_px + 1);
+            m_epsilon_horiz = 1.0f / (m_src_window.width_px + 1);
+            m_epsilon_vert = 1.0f / (m_src_window.height_px + 1);
             m_block_x = 0;
             m_block_y = 0;
 
@@ -73,8 +110,8 @@ class DownscalingBlockWriter : public BlockWriter {
         /// discarded in the downscaling process.
         ///
         /// \note
-        /// - Blocks from a particular region of interest are presumed served in
-        ///   the order in which they appear in the entropy-coded segment.
+        /// - Blocks are presumed served in raster order within the region of
+        ///   interest.
         /// - All expected output is written to the destination by the time the
         ///   function finishes with its last input block.
         ///
@@ -83,21 +120,29 @@ class DownscalingBlockWriter : public BlockWriter {
         /// not limited to integral downscaling factors. Instead, true rational
         /// downscaling factors (horizontal and vertical separately) are
         /// approximated by floating point values with corrections to rounding
-        /// errors if necessary.
+        /// errors if necessary. When cropping, blocks on the edges of the
+        /// window are treated as smaller blocks made up of their pixels within
+        /// the window only.
         void write(int (&src_block)[64]) noexcept override {
 
+            // pixels of src block within the window
+            const BlockSpan span = clip_block();
+
+            if (span.is_empty()) {
+
+                advance_block();
+                return;
+            }
+
             // src block west border X-coord expressed in dst pixels
-            float block_west = m_horiz_scaling_factor * m_block_x;
+            float block_west = m_horiz_scaling_factor * (m_block_x + span.col_begin - m_src_window.x_px);
 
             // src block north border Y-coord expressed in dst pixels
-            float north = m_vert_scaling_factor * m_block_y;
+            float north = m_vert_scaling_factor * (m_block_y + span.row_begin - m_src_window.y_px);
 
             // correct minor floating point error
             north = snap_to_vert_grid(north);
 
-            // 1D index (0-63) of pixels within 8x8 src block
-            uint8_t src_idx = 0;
-
             // column buffer index used for dst block's easternmost pixels' partial values
             uint8_t col_buff_idx = 0;
 
@@ -107,17 +152,21 @@ class DownscalingBlockWriter : public BlockWriter {
             // index of first pixel in row buffer relevant to the current src block
             const auto floor_block_west = static_cast<uint16_t>(block_west);
 
-            for (uint row = 0; row < 8; ++row) {
+            // easternmost column and southernmost row of src block within the window
+            const uint last_col = span.col_end - 1;
+            const uint last_row = span.row_end - 1;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
 
                 // (re)start row at block west border on each src row scan
                 float west = block_west;
 
+                // 1D index (0-63) of pixels within 8x8 src block
+                uint8_t src_idx = row * 8 + span.col_begin;
+
                 // dst row index overlayed by north portion of src row
                 const auto floor_north = static_cast<uint16_t>(north);
 
-                // current dst row index offset from start of array
-                const uint32_t vert_offset = DST_WIDTH_PX * floor_north;
-
                 // south border of src row expressed in dst pixels
                 float south = north + m_vert_scaling_factor;
 
@@ -135,7 +184,7 @@ class DownscalingBlockWriter : public BlockWriter {
                                              1.0f : (floor_south - north) / m_vert_scaling_factor;
 
                 // if src and dst rows are aligned along their north borders or if starting new block
-                if (floor_north == north || row == 0) {
+                if (floor_north == north || row == span.row_begin) {
 
                     // carry over from north position column buffer
                     m_row_buffer[floor_block_west] += m_column_buffer[col_buff_idx];
@@ -150,7 +199,7 @@ class DownscalingBlockWriter : public BlockWriter {
                     m_column_buffer[col_buff_idx + 1] = 0.0f;
                 }
 
-                for (uint col = 0; col < 8; ++col) {
+                for (uint col = span.col_begin; col < span.col_end; ++col) {
 
                     // src column east border X-coord expressed in dst columns X-coords
                     float east = west + m_horiz_scaling_factor;
@@ -187,26 +236,25 @@ class DownscalingBlockWriter : public BlockWriter {
                     // east-aligned columns *and* src row reaches up to or into next dst row
                     if (east == floor_east && src_row_spans_next_dst_row) {
 
-                        const uint dst_val = std::lround(m_row_buffer[floor_west] * m_val_norm_factor);
-                        m_dst[vert_offset + floor_west] = dst_val <= 255 ? dst_val : 255;
+                        m_output.write(m_dst, m_dst_pitch_px, floor_west, floor_north, m_row_buffer[floor_west] * m_val_norm_factor);
                         m_row_buffer[floor_west] = m_edge_buffer;
                         m_edge_buffer = 0.0f;
-                        col_buff_idx += col == 7;
+                        col_buff_idx += col == last_col;
                     }
 
                     // src column is otherwise contained within single dst column
                     else if (floor_west == floor_east) {
 
-                        if  (col == 7) {
+                        if  (col == last_col) {
 
-                            if (src_row_spans_next_dst_row || row == 7) {
+                            if (src_row_spans_next_dst_row || row == last_row) {
 
                                 m_column_buffer[col_buff_idx++] = m_row_buffer[floor_west];
                                 m_row_buffer[floor_west] = m_edge_buffer;
                                 m_edge_buffer = 0.0f;
                             }
 
-                            if (north_fraction != 1.0f && row == 7) {
+                            if (north_fraction != 1.0f && row == last_row) {
 
                                 m_column_buffer[col_buff_idx] = m_row_buffer[floor_west];
                                 m_row_buffer[floor_west] = 0.0f;
@@ -219,12 +267,11 @@ class DownscalingBlockWriter : public BlockWriter {
 
                         if (src_row_spans_next_dst_row) {
 
-                            const uint dst_val = std::lround(m_row_buffer[floor_west] * m_val_norm_factor);
-                            m_dst[vert_offset + floor_west] = dst_val <= 255 ? dst_val : 255;
+                            m_output.write(m_dst, m_dst_pitch_px, floor_west, floor_north, m_row_buffer[floor_west] * m_val_norm_factor);
                             m_row_buffer[floor_west] = m_edge_buffer;
                         }
 
-                        if (col == 7) {
+                        if (col == last_col) {
 
                             m_edge_buffer = 0.0f;
                             m_column_buffer[col_buff_idx] += north_east_val;
@@ -247,17 +294,19 @@ class DownscalingBlockWriter : public BlockWriter {
                 north = south;
             }
 
-            m_block_x += 8;
+            advance_block();
+        }
 
-            if (m_block_x == m_src_width_px) {
+        /// \brief Accessor for the output policy, e.g. for its configuration.
+        Output& get_output() noexcept {
 
-                m_block_x = 0;
-                m_block_y += 8;
-            }
+            return m_output;
         }
 
     private:
 
+        Output m_output {};
+
         float m_horiz_scaling_factor {};
         float m_vert_scaling_factor {};
         float m_val_norm_factor {};
@@ -268,6 +317,18 @@ class DownscalingBlockWriter : public BlockWriter {
         float m_column_buffer[9] {};  // size is 9 == one greater than block height in pixels
         float m_row_buffer[DST_WIDTH_PX] {};
 
+        // advance to the next src block position within the region of interest
+        void advance_block() noexcept {
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
         // snap floating point input to integer grid within `m_epsilon_horiz` proximity
         float snap_to_horiz_grid(const float input) const noexcept {
 
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <cmath>
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Neighborhood filters available to FilteringBlockWriter.
+enum class Filter : uint8_t {
+    GAUSSIAN_5X5,     ///< blurred luma, binomial kernel `[1 4 6 4 1]` in both directions
+    SOBEL_MAGNITUDE,  ///< 3x3 Sobel gradient magnitude, `(|gx| + |gy|) / 8` rounded
+    SOBEL_DIRECTION   ///< 3x3 Sobel gradient direction, `atan2(gy, gx)` mapped to 256 steps per full turn
+};
+
+/// \brief Implements BlockWriter for block-wise writing with neighborhood filtering.
+///
+/// \tparam FILTER        Filter to apply.
+/// \tparam MAX_WIDTH_PX  Maximum width of the region of interest in pixels.
+///
+/// Output has the same dimensions as the region of interest. Pixels outside
+/// the region of interest are substituted by the nearest pixels inside it
+/// (clamped borders). Supports cropping (see BlockWriter::set_src_window),
+/// output is then written for the window of pixels only and the window takes
+/// the place of the region of interest above, so that padding pixels of
+/// partial blocks on the right and bottom frame edges are never filtered
+/// against. For Sobel filters, \c gx grows to the east (right) and
+/// \c gy grows to the south (down), so the direction 64 points down.
+///
+/// \par Implementation Details
+/// Decoded pixels are kept in a ring buffer of 16 rows, large enough to hold
+/// the band of 8 rows being decoded plus the halo of up to 4 rows of the band
+/// above it. Ring rows are padded with copies of their edge pixels to provide
+/// the halo on the west and east sides. The last block of every band
+/// completes the neighborhoods of its rows of output pixels (8 within the
+/// window), shifted up by the filter's radius, which are therefore filtered
+/// and written right away (the first and the last band complete fewer and
+/// more rows respectively).
+/// Filters are evaluated separably and in whole rows rather than per block, so
+/// that no halo columns are summed twice: vertical sums first, horizontal sums
+/// of those second.
+template <Filter FILTER, uint16_t MAX_WIDTH_PX>
+class FilteringBlockWriter final : public BlockWriter {
+
+    static_assert(MAX_WIDTH_PX % 8 == 0, "maximum width must be a multiple of 8");
+
+    public:
+
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Raw pixel buffer for writing output to, minimum
+        ///                       size is `src_width_px * src_height_px` (the
+        ///                       size of the window if cropping) unless set
+        ///                       otherwise by set_dst_layout().
+        /// \param src_width_px   Width of the region of interest expressed in
+        ///                       pixels, no greater than \c MAX_WIDTH_PX.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written to destination
+        /// buffer.
+        void init(uint8_t* const dst, const uint16_t src_width_px, const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            init_dst(dst, m_src_window.width_px);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+            m_filtered_rows = 0;
+        }
+
+        /// \brief Performs a single block write with filtering.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// Each call buffers the input block and writes all output pixels whose
+        /// neighborhoods it completes, i.e. rows of output pixels after the last
+        /// block of every band.
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        void write(int (&src_block)[64]) noexcept override {
+
+            // rows and columns of the block within the window, ring rows and columns are relative to the window
+            const BlockSpan span = clip_block();
+            const int x = m_block_x - m_src_window.x_px;
+            const int y = m_block_y - m_src_window.y_px;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                uint8_t* const ring_row = m_ring[(y + row) % RING_ROWS];
+
+                for (uint col = span.col_begin; col < span.col_end; ++col) {
+
+                    ring_row[RADIUS + x + col] = src_block[row * 8 + col];
+                }
+            }
+
+            // last block of the band completes neighborhoods of whole rows of output pixels
+            if (m_block_x + 8 == m_src_width_px && span.row_begin != span.row_end) {
+
+                pad_band(span);
+
+                const int band_end = y + span.row_end;
+                const int y2 = band_end == m_src_window.height_px ? band_end : band_end - static_cast<int>(RADIUS);
+
+                for (; static_cast<int>(m_filtered_rows) < y2; ++m_filtered_rows) {
+
+                    filter_row(m_filtered_rows);
+                }
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+    private:
+
+        // filter radius in pixels
+        static constexpr uint RADIUS = FILTER == Filter::GAUSSIAN_5X5 ? 2 : 1;
+
+        // power of two no less than block height plus the halo above it
+        static constexpr uint RING_ROWS = 16;
+
+        // row width including padding columns for the halo on both sides
+        static constexpr uint PADDED_WIDTH_PX = MAX_WIDTH_PX + 2 * RADIUS;
+
+        static constexpr float PI = 3.14159265358979f;
+
+        // count of rows of output pixels already filtered and written
+        uint16_t m_filtered_rows {};
+
+        uint8_t m_ring[RING_ROWS][PADDED_WIDTH_PX] {};
+
+        // vertical smoothing and (Sobel only) differentiating sums of the row being filtered
+        int m_smooth[PADDED_WIDTH_PX] {};
+        int m_diff[PADDED_WIDTH_PX] {};
+
+        // replicates west and east edge pixels of the current band's rows within the window into padding columns
+        void pad_band(const BlockSpan& span) noexcept {
+
+            const uint16_t width_px = m_src_window.width_px;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                uint8_t* const ring_row = m_ring[(m_block_y - m_src_window.y_px + row) % RING_ROWS];
+
+                for (uint i = 0; i < RADIUS; ++i) {
+
+                    ring_row[i] = ring_row[RADIUS];
+                    ring_row[RADIUS + width_px + i] = ring_row[RADIUS + width_px - 1];
+                }
+            }
+        }
+
+        // filters dst row y
+        void filter_row(const uint16_t y) noexcept {
+
+            const uint8_t* rows[2 * RADIUS + 1];
+
+            for (uint i = 0; i <= 2 * RADIUS; ++i) {
+
+                const int row = clamp(static_cast<int>(y) + static_cast<int>(i) - static_cast<int>(RADIUS), m_src_window.height_px);
+                rows[i] = m_ring[row % RING_ROWS];
+            }
+
+            // vertical sums of padded columns
+            const uint padded_width_px = m_src_window.width_px + 2 * RADIUS;
+
+            for (uint i = 0; i < padded_width_px; ++i) {
+
+                if constexpr (FILTER == Filter::GAUSSIAN_5X5) {
+
+                    m_smooth[i] = rows[0][i] + 4 * rows[1][i] + 6 * rows[2][i] + 4 * rows[3][i] + rows[4][i];
+                }
+
+                else {
+
+                    m_smooth[i] = rows[0][i] + 2 * rows[1][i] + rows[2][i];
+                    m_diff[i] = rows[2][i] - rows[0][i];
+                }
+            }
+
+            uint8_t* const dst = m_dst + y * m_dst_pitch_px;
+
+            for (uint x = 0; x < m_src_window.width_px; ++x) {
+
+                // column sums of the pixel's neighborhood, starting at its west edge
+                const int* const s = &m_smooth[x];
+                const int* const d = &m_diff[x];
+
+                if constexpr (FILTER == Filter::GAUSSIAN_5X5) {
+
+                    dst[x] = (s[0] + 4 * s[1] + 6 * s[2] + 4 * s[3] + s[4] + 128) / 256;
+                }
+
+                else {
+
+                    const int gx = s[2] - s[0];
+                    const int gy = d[0] + 2 * d[1] + d[2];
+
+                    if constexpr (FILTER == Filter::SOBEL_MAGNITUDE) {
+
+                        dst[x] = (std::abs(gx) + std::abs(gy) + 4) / 8;
+                    }
+
+                    else {
+
+                        dst[x] = gx || gy ? std::lround(std::atan2(static_cast<float>(gy), static_cast<float>(gx)) * (128.0f / PI)) & 0xff : 0;
+                    }
+                }
+            }
+        }
+
+        // clamps coordinate to [0, size)
+        static int clamp(const int coord, const uint16_t size) noexcept {
+
+            return coord < 0 ? 0 : (coord >= size ? size - 1 : coord);
+        }
+};
+
+}  // namespace mdjpeg
@@ -5,12 +5,98 @@
     #include <fmt/core.h>
 #endif
 
+#include <algorithm>
+
 #include "JpegReader.h"
 #include "ReadError.h"
 
 
 using namespace mdjpeg;
 
+namespace {
+
+// Huffman table with its codes generated at compile time
+template <size_t SYMBOLS_COUNT>
+struct TypicalHuffmanTable {
+
+    constexpr TypicalHuffmanTable(const uint8_t (&histogram)[16], const uint8_t (&symbols)[SYMBOLS_COUNT]) noexcept {
+
+        uint16_t curr_huff_code = 0;
+        uint idx = 0;
+
+        for (uint i = 0; i < 16; ++i) {
+
+            this->histogram[i] = histogram[i];
+            curr_huff_code <<= 1;
+
+            for (uint j = 0; j < histogram[i]; ++j) {
+
+                this->symbols[idx] = symbols[idx];
+                codes[idx++] = curr_huff_code++;
+            }
+        }
+    }
+
+    uint8_t histogram[16] {};
+    uint8_t symbols[SYMBOLS_COUNT] {};
+    uint16_t codes[SYMBOLS_COUNT] {};
+};
+
+// typical tables from ITU-T T.81 Annex K.3 (tables K.3 to K.6)
+// luma DC DCT coefficient lengths
+constexpr TypicalHuffmanTable<12> LUMA_DC {
+    {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0},
+    {
+     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b
+    }
+};
+
+// chroma DC DCT coefficient lengths
+constexpr TypicalHuffmanTable<12> CHROMA_DC {
+    {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0},
+    {
+     0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b
+    }
+};
+
+// luma AC run lengths and DCT coefficient lengths
+constexpr TypicalHuffmanTable<162> LUMA_AC {
+    {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 125},
+    {
+     0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+     0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+     0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+     0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+     0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+     0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+     0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+     0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+     0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+     0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+     0xf9, 0xfa
+    }
+};
+
+// chroma AC run lengths and DCT coefficient lengths
+constexpr TypicalHuffmanTable<162> CHROMA_AC {
+    {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 119},
+    {
+     0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+     0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+     0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+     0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+     0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+     0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+     0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+     0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+     0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+     0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+     0xf9, 0xfa
+    }
+};
+
+}  // namespace
+
 uint16_t Huffman::set_htable(JpegReader& reader, uint16_t max_read_length) noexcept {
 
     const uint8_t next_byte = *reader.read_uint8();
@@ -42,9 +128,27 @@ uint16_t Huffman::set_htable(JpegReader& reader, uint16_t max_read_length) noexc
     }
 
     HuffmanTable& huff_table = m_htables[table_id][is_ac];
-    huff_table.histogram = reader.tell_ptr();
-    reader.seek(16);
-    huff_table.symbols = reader.tell_ptr();
+    const uint8_t* const histogram = reader.tell_ptr();
+    const uint8_t* const symbols = histogram + 16;
+
+    huff_table.histogram = huff_table.histogram_buff;
+    huff_table.symbols = huff_table.symbols_buff;
+    huff_table.codes = huff_table.codes_buff;
+    huff_table.is_set = true;
+
+    reader.seek(16 + symbols_count);
+
+    // table identical to the copy kept from previous frames, its codes are still valid
+    if (symbols_count == huff_table.buff_symbols_count
+        && std::equal(histogram, symbols, huff_table.histogram_buff)
+        && std::equal(symbols, symbols + symbols_count, huff_table.symbols_buff)) {
+
+        return 1 + 16 + symbols_count;
+    }
+
+    std::copy(histogram, symbols, huff_table.histogram_buff);
+    std::copy(symbols, symbols + symbols_count, huff_table.symbols_buff);
+    huff_table.buff_symbols_count = symbols_count;
 
     #ifdef PRINT_HUFFMAN_TABLES
         std::cout << "\nHuffman table id " << (int)table_id;
@@ -72,7 +176,7 @@ uint16_t Huffman::set_htable(JpegReader& reader, uint16_t max_read_length) noexc
 
         for (uint j = 0; j < huff_table.histogram[i]; ++j) {
 
-            huff_table.codes[idx] = curr_huff_code;
+            huff_table.codes_buff[idx] = curr_huff_code;
 
             #ifdef PRINT_HUFFMAN_TABLES
                 fmt::print("  {: >2}: {:0>{}b} -> 0x{:0>2x}\n",
@@ -86,18 +190,26 @@ uint16_t Huffman::set_htable(JpegReader& reader, uint16_t max_read_length) noexc
         }
     }
 
-    huff_table.is_set = true;
-
-    reader.seek(symbols_count);
-
     return 1 + 16 + symbols_count;
 }
 
-bool Huffman::is_set() const noexcept {
+void Huffman::set_default_htables() noexcept {
+
+    const auto set_default = [](HuffmanTable& huff_table, const auto& typical_table) noexcept {
 
-    return (m_htables[0].dc.is_set && m_htables[0].ac.is_set
-                                   && m_htables[1].dc.is_set
-                                   && m_htables[1].ac.is_set);
+        if (!huff_table.is_set) {
+
+            huff_table.histogram = typical_table.histogram;
+            huff_table.symbols = typical_table.symbols;
+            huff_table.codes = typical_table.codes;
+            huff_table.is_set = true;
+        }
+    };
+
+    set_default(m_htables[0].dc, LUMA_DC);
+    set_default(m_htables[0].ac, LUMA_AC);
+    set_default(m_htables[1].dc, CHROMA_DC);
+    set_default(m_htables[1].ac, CHROMA_AC);
 }
 
 void Huffman::clear() noexcept {
@@ -106,6 +218,19 @@ void Huffman::clear() noexcept {
     m_htables[1].dc.is_set = false;
     m_htables[1].ac.is_set = false;
 
+    // forces restart of the ECS (of a possibly different image) on next decode
+    m_block_idx = UINT32_MAX;
+    m_row_checkpoint.block_idx = UINT32_MAX;
+    m_indexed_mcus_count = 0;
+
+    m_is_dc_scan = false;
+    m_point_transform = 0;
+}
+
+void Huffman::set_dc_scan(const uint8_t point_transform) noexcept {
+
+    m_is_dc_scan = true;
+    m_point_transform = point_transform;
 }
 
 uint8_t Huffman::get_symbol(JpegReader& reader, const uint8_t table_id, const uint8_t is_ac) const noexcept {
@@ -171,44 +296,262 @@ int16_t Huffman::get_dct_coeff(JpegReader& reader, const uint8_t length) noexcep
     return dct_coeff;
 }
 
-bool Huffman::decode_luma_block(JpegReader& reader, int (&dst_block)[64], const uint32_t luma_block_idx, const uint8_t horiz_chroma_subs_factor) noexcept {
+void Huffman::set_mcu_layout(const uint16_t width_px,
+                             const uint8_t horiz_chroma_subs_factor,
+                             const uint8_t vert_chroma_subs_factor,
+                             const uint8_t components_count) noexcept {
 
-    // if already beyond the requested `luma_block_idx`
-    if (m_luma_block_idx > luma_block_idx) {
+    m_is_grayscale = components_count == 1;
+    m_mcu_width_blk = horiz_chroma_subs_factor;
+    m_mcu_height_blk = vert_chroma_subs_factor;
+    m_mcu_luma_blocks_count = horiz_chroma_subs_factor * vert_chroma_subs_factor;
 
-        m_block_idx = 0;
-        m_luma_block_idx = 0;
-        m_previous_luma_dc_coeff = 0;
-        reader.restart_ecs();
+    // partial MCUs at the east edge are padded to whole ones
+    const uint16_t mcu_width_px = 8 * horiz_chroma_subs_factor;
+    m_width_mcu = (width_px + mcu_width_px - 1) / mcu_width_px;
+}
+
+bool Huffman::decode_luma_block(JpegReader& reader, int (&dst_block)[64], const uint16_t col_blk, const uint16_t row_blk) noexcept {
+
+    if (m_is_grayscale) {
+
+        return decode_grayscale_block(reader, dst_block, static_cast<uint32_t>(row_blk) * m_width_mcu + col_blk);
     }
 
-    while (m_luma_block_idx <= luma_block_idx) {
+    // luma blocks come first in every MCU in raster order, followed by one Cb and one Cr block
+    const uint32_t mcu_idx = static_cast<uint32_t>(row_blk / m_mcu_height_blk) * m_width_mcu + col_blk / m_mcu_width_blk;
+    const uint8_t mcu_luma_idx = (row_blk % m_mcu_height_blk) * m_mcu_width_blk + col_blk % m_mcu_width_blk;
+    const uint32_t block_idx = mcu_idx * (2 + m_mcu_luma_blocks_count) + mcu_luma_idx;
 
-        // following is true for any luma block in either 4:4:4 or 4:2:2 chroma subsampling modes
-        if (m_block_idx % (2 + horiz_chroma_subs_factor) < horiz_chroma_subs_factor) {
+    return skip_to_block(reader, block_idx)
+           && decode_predicted_block(reader, dst_block);
+}
 
-            if (!decode_next_block(reader, dst_block, 0)) {
+bool Huffman::decode_mcu(JpegReader& reader, int (&dst_blocks)[6][64], const uint32_t mcu_idx) noexcept {
 
-                return false;
-            }
+    const uint8_t blocks_count = 2 + m_mcu_luma_blocks_count;
 
-            dst_block[0] += m_previous_luma_dc_coeff;
-            m_previous_luma_dc_coeff = dst_block[0];
-            ++m_luma_block_idx;
+    if (!skip_to_block(reader, mcu_idx * blocks_count)) {
+
+        return false;
+    }
+
+    for (uint i = 0; i < blocks_count; ++i) {
+
+        if (!decode_predicted_block(reader, dst_blocks[i])) {
+
+            return false;
         }
+    }
+
+    return true;
+}
 
-        // otherwise chroma block, read through and skip over
-        else if (!decode_next_block(reader, dst_block, 1)) {
+bool Huffman::decode_mcu_dc(JpegReader& reader, int (&dst_dc_coeffs)[6], const uint32_t mcu_idx) noexcept {
+
+    const uint8_t blocks_count = 2 + m_mcu_luma_blocks_count;
+
+    if (!skip_to_block(reader, mcu_idx * blocks_count)) {
+
+        return false;
+    }
+
+    int dc_coeff = 0;
+
+    for (uint i = 0; i < blocks_count; ++i) {
+
+        update_row_checkpoint(reader);
+
+        const uint8_t component = get_component(m_block_idx);
+
+        if (!skip_next_block(reader, dc_coeff, component > 0)) {
+
+            return false;
+        }
+
+        m_previous_dc_coeffs[component] += dc_coeff;
+        dst_dc_coeffs[i] = m_previous_dc_coeffs[component];
+        ++m_block_idx;
+    }
+
+    return true;
+}
+
+bool Huffman::skip_to_block(JpegReader& reader, const uint32_t block_idx) noexcept {
+
+    // unless moved straight to indexed lower luma blocks, go back as little as possible if already beyond the requested `block_idx`
+    if (!seek_lower_blocks(reader, block_idx) && m_block_idx > block_idx) {
+
+        if (m_row_checkpoint.block_idx <= block_idx) {
+
+            reader.seek_ecs_position(m_row_checkpoint.position);
+            m_block_idx = m_row_checkpoint.block_idx;
+            m_previous_dc_coeffs[0] = m_row_checkpoint.previous_dc_coeffs[0];
+            m_previous_dc_coeffs[1] = m_row_checkpoint.previous_dc_coeffs[1];
+            m_previous_dc_coeffs[2] = m_row_checkpoint.previous_dc_coeffs[2];
+
+            // same MCU row, checkpoint and index remain valid
+            m_next_row_block_idx = m_block_idx + m_width_mcu * (2u + m_mcu_luma_blocks_count);
+        }
+
+        else {
+
+            m_block_idx = 0;
+            m_previous_dc_coeffs[0] = 0;
+            m_previous_dc_coeffs[1] = 0;
+            m_previous_dc_coeffs[2] = 0;
+            m_next_row_block_idx = 0;
+            reader.restart_ecs();
+        }
+    }
+
+    int dc_coeff = 0;
+
+    while (m_block_idx < block_idx) {
+
+        update_row_checkpoint(reader);
+
+        const uint8_t component = get_component(m_block_idx);
+
+        // only DC DCT coefficients of blocks skipped over are needed (for prediction)
+        if (!skip_next_block(reader, dc_coeff, component > 0)) {
 
             return false;
         }
 
+        m_previous_dc_coeffs[component] += dc_coeff;
         ++m_block_idx;
     }
 
     return true;
 }
 
+bool Huffman::decode_predicted_block(JpegReader& reader, int (&dst_block)[64]) noexcept {
+
+    update_row_checkpoint(reader);
+
+    const uint8_t component = get_component(m_block_idx);
+
+    if (!decode_next_block(reader, dst_block, component > 0)) {
+
+        return false;
+    }
+
+    dst_block[0] += m_previous_dc_coeffs[component];
+    m_previous_dc_coeffs[component] = dst_block[0];
+    ++m_block_idx;
+
+    return true;
+}
+
+bool Huffman::decode_grayscale_block(JpegReader& reader, int (&dst_block)[64], const uint32_t block_idx) noexcept {
+
+    // blocks are in raster order, a single DC predictor, no MCU row checkpoints
+    if (m_block_idx > block_idx) {
+
+        m_block_idx = 0;
+        m_previous_dc_coeffs[0] = 0;
+        reader.restart_ecs();
+    }
+
+    int dc_coeff = 0;
+
+    for (; m_block_idx < block_idx; ++m_block_idx) {
+
+        if (!skip_next_block(reader, dc_coeff, 0)) {
+
+            return false;
+        }
+
+        m_previous_dc_coeffs[0] += dc_coeff;
+    }
+
+    if (!decode_next_block(reader, dst_block, 0)) {
+
+        return false;
+    }
+
+    dst_block[0] += m_previous_dc_coeffs[0];
+    m_previous_dc_coeffs[0] = dst_block[0];
+    ++m_block_idx;
+
+    return true;
+}
+
+void Huffman::update_row_checkpoint(const JpegReader& reader) noexcept {
+
+    const uint8_t mcu_blocks_count = 2 + m_mcu_luma_blocks_count;
+
+    // mostly false (true once per MCU row)
+    if (m_block_idx == m_next_row_block_idx) {
+
+        m_row_checkpoint.position = reader.tell_ecs_position();
+        m_row_checkpoint.block_idx = m_block_idx;
+        m_row_checkpoint.previous_dc_coeffs[0] = m_previous_dc_coeffs[0];
+        m_row_checkpoint.previous_dc_coeffs[1] = m_previous_dc_coeffs[1];
+        m_row_checkpoint.previous_dc_coeffs[2] = m_previous_dc_coeffs[2];
+
+        m_next_row_block_idx += static_cast<uint32_t>(m_width_mcu) * mcu_blocks_count;
+        m_indexed_mcus_count = 0;
+    }
+
+    // index the first lower luma block of every MCU once, in ECS order
+    if (m_mcu_height_blk == 2 && m_block_idx % mcu_blocks_count == m_mcu_width_blk) {
+
+        const uint32_t entry_idx = (m_block_idx - m_row_checkpoint.block_idx) / mcu_blocks_count;
+
+        if (entry_idx == m_indexed_mcus_count && entry_idx < MAX_INDEXED_MCUS) {
+
+            auto& entry = m_lower_blocks_index[entry_idx];
+            entry.position = reader.tell_ecs_position();
+            entry.previous_dc_coeffs[0] = m_previous_dc_coeffs[0];
+            entry.previous_dc_coeffs[1] = m_previous_dc_coeffs[1];
+            entry.previous_dc_coeffs[2] = m_previous_dc_coeffs[2];
+            ++m_indexed_mcus_count;
+        }
+    }
+}
+
+bool Huffman::seek_lower_blocks(JpegReader& reader, const uint32_t block_idx) noexcept {
+
+    const uint8_t mcu_blocks_count = 2 + m_mcu_luma_blocks_count;
+    const uint8_t mcu_block_idx = block_idx % mcu_blocks_count;
+
+    // lower luma blocks only
+    if (m_mcu_height_blk != 2 || mcu_block_idx < m_mcu_width_blk || mcu_block_idx >= m_mcu_luma_blocks_count) {
+
+        return false;
+    }
+
+    const uint32_t lower_block_idx = block_idx - mcu_block_idx + m_mcu_width_blk;
+
+    // already there or in between
+    if (m_block_idx >= lower_block_idx && m_block_idx <= block_idx) {
+
+        return false;
+    }
+
+    // MCUs of the current MCU row indexed so far only
+    if (m_row_checkpoint.block_idx > block_idx
+        || (lower_block_idx - m_row_checkpoint.block_idx) / mcu_blocks_count >= m_indexed_mcus_count) {
+
+        return false;
+    }
+
+    const auto& entry = m_lower_blocks_index[(lower_block_idx - m_row_checkpoint.block_idx) / mcu_blocks_count];
+
+    reader.seek_ecs_position(entry.position);
+    m_block_idx = lower_block_idx;
+    m_previous_dc_coeffs[0] = entry.previous_dc_coeffs[0];
+    m_previous_dc_coeffs[1] = entry.previous_dc_coeffs[1];
+    m_previous_dc_coeffs[2] = entry.previous_dc_coeffs[2];
+
+    // same MCU row, checkpoint and index remain valid
+    m_next_row_block_idx = m_row_checkpoint.block_idx + m_width_mcu * static_cast<uint32_t>(mcu_blocks_count);
+
+    return true;
+}
+
 bool Huffman::decode_next_block(JpegReader& reader, int (&dst_block)[64], const uint8_t table_id) const noexcept {
 
     const uint8_t dc = 0;
@@ -232,7 +575,18 @@ bool Huffman::decode_next_block(JpegReader& reader, int (&dst_block)[64], const
         return false;
     }
 
-    dst_block[0] = dc_dct_coeff;
+    dst_block[0] = dc_dct_coeff * (1 << m_point_transform);
+
+    // blocks of DC scans end with their DC DCT coefficient
+    if (m_is_dc_scan) {
+
+        for (uint idx = 1; idx < 64; ++idx) {
+
+            dst_block[idx] = 0;
+        }
+
+        return true;
+    }
 
     /////////////////////////////////
     // process AC DCT coefficients //
@@ -299,3 +653,83 @@ bool Huffman::decode_next_block(JpegReader& reader, int (&dst_block)[64], const
 
     return true;
 }
+
+bool Huffman::skip_next_block(JpegReader& reader, int& dc_coeff, const uint8_t table_id) const noexcept {
+
+    const uint8_t dc = 0;
+    const uint8_t ac = 1;
+
+    ////////////////////////////////
+    // process DC DCT coefficient //
+
+    const uint8_t dc_huff_symbol = get_symbol(reader, table_id, dc);
+
+    // DC DCT coefficient length out of range
+    if (dc_huff_symbol > 11) {
+
+        return false;
+    }
+
+    const int16_t dc_dct_coeff = get_dct_coeff(reader, dc_huff_symbol);
+
+    if (dc_dct_coeff == ReadError::DCT_COEF) {
+
+        return false;
+    }
+
+    dc_coeff = dc_dct_coeff * (1 << m_point_transform);
+
+    if (m_is_dc_scan) {
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////
+    // read through AC DCT coefficients without decoding //
+
+    uint idx = 1;
+
+    while (idx < 64) {
+
+        const uint8_t ac_huff_symbol = get_symbol(reader, table_id, ac);
+
+        if (ac_huff_symbol == ReadError::HUFF_SYMBOL) {
+
+            return false;
+        }
+
+        // 0x00 means the rest of coefficients are 0
+        if (ac_huff_symbol == 0x00) {
+
+            break;
+        }
+
+        const uint8_t pre_zeros_count = ac_huff_symbol == 0xf0 ? 16 : ac_huff_symbol >> 4;
+
+        // same validation as in decode_next_block
+        if (idx + pre_zeros_count >= 64) {
+
+            return false;
+        }
+
+        idx += pre_zeros_count;
+
+        // nothing more to do for 0xf0
+        if (ac_huff_symbol == 0xf0) {
+
+            continue;
+        }
+
+        const uint8_t ac_dct_coeff_length = ac_huff_symbol & 0xf;
+
+        // AC DCT coefficient length out of range
+        if (ac_dct_coeff_length > 10 || !reader.skip_bits(ac_dct_coeff_length)) {
+
+            return false;
+        }
+
+        ++idx;
+    }
+
+    return true;
+}
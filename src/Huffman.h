@@ -3,15 +3,14 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+#include "JpegReader.h"
 
-namespace mdjpeg {
-
-class JpegReader;
 
+namespace mdjpeg {
 
 /// \brief Provides %Huffman decoding facilities specific to JFIF data.
 ///
-/// Reads %Huffman symbols from JFIF header and stores (pointers to) them.
+/// Reads %Huffman symbols from JFIF header and stores copies of them.
 /// Generates %Huffman codes. Decodes JFIF %Huffman stream block by block.
 class Huffman {
 
@@ -20,35 +19,147 @@ class Huffman {
         /// \brief Populates %Huffman tables starting at \c reader cursor.
         ///
         /// \return  Number of bytes read through from the JFIF segment.
+        ///
+        /// Tables are copied, so they do not depend on the JFIF data once set.
+        /// Copies and their generated codes are kept across clear(), so a table
+        /// identical to the one last set in its slot (as repeated by every
+        /// frame of an MJPEG stream) is reused as it is, without generating
+        /// its codes again.
         uint16_t set_htable(JpegReader& reader, uint16_t max_read_length) noexcept;
 
-        /// \brief Checks if all (DC/AC-luma/chroma) %Huffman tables are validly set.
-        bool is_set() const noexcept;
+        /// \brief Populates %Huffman tables not set by set_htable() with the typical ones.
+        ///
+        /// Typical tables are those of ITU-T T.81 Annex K.3, commonly relied
+        /// upon by MJPEG streams (e.g. AVI1 frames of USB and IP cameras) which
+        /// omit \e DHT segments. The tables, including their %Huffman codes,
+        /// are compile-time constants, so nothing is generated per frame.
+        void set_default_htables() noexcept;
 
         /// \brief Invalidates all (DC/AC-luma/chroma) %Huffman tables even if populated.
+        ///
+        /// Copies of the tables are kept for reuse by set_htable().
         void clear() noexcept;
 
-        /// \brief Decodes a luma block by its index.
+        /// \brief Switches to decoding of the first DC scan of a progressive frame.
+        ///
+        /// \param point_transform  Successive approximation bit position low of
+        ///                         the scan, DC DCT coefficients are scaled up by
+        ///                         `2 ^ point_transform`.
+        ///
+        /// Blocks of the scan consist of their DC DCT coefficient only, all AC
+        /// DCT coefficients of decoded blocks are zero. Reset by clear().
+        void set_dc_scan(uint8_t point_transform) noexcept;
+
+        /// \brief Sets the layout of minimum coded units (MCUs) of the frame.
         ///
-        /// \retval  true on success.
-        /// \retval  false on failure.
-        bool decode_luma_block(JpegReader& reader, int (&dst_block)[64], uint32_t luma_block_idx, uint8_t horiz_chroma_subs_factor) noexcept;
+        /// \param width_px                  Frame width expressed in pixels.
+        /// \param horiz_chroma_subs_factor  Luma blocks per MCU horizontally (1 or 2).
+        /// \param vert_chroma_subs_factor   Luma blocks per MCU vertically (1 or 2).
+        /// \param components_count          1 for grayscale frames, 3 for Y'CbCr frames.
+        ///
+        /// Every MCU consists of its luma blocks in raster order followed by one
+        /// Cb and one Cr block. MCUs of grayscale frames are single luma blocks
+        /// and are decoded by a specialized path free of MCU layout logic.
+        /// Needs to be called before decoding any blocks.
+        void set_mcu_layout(uint16_t width_px, uint8_t horiz_chroma_subs_factor, uint8_t vert_chroma_subs_factor, uint8_t components_count) noexcept;
+
+        /// \brief Decodes a luma block by its position within the frame.
+        ///
+        /// \param col_blk  Column of the block expressed in 8x8 blocks.
+        /// \param row_blk  Row of the block expressed in 8x8 blocks.
+        /// \retval         true on success.
+        /// \retval         false on failure.
+        ///
+        /// Blocks are best requested in raster order. With 2 rows of luma
+        /// blocks per MCU (4:2:0 chroma subsampling) raster order differs from
+        /// the order of blocks in the ECS. Requesting the second row of blocks
+        /// of an MCU row then resumes reading at the start of that MCU row
+        /// rather than at the start of the ECS.
+        bool decode_luma_block(JpegReader& reader, int (&dst_block)[64], uint16_t col_blk, uint16_t row_blk) noexcept;
+
+        /// \brief Decodes all blocks of a minimum coded unit (MCU) by its index.
+        ///
+        /// \param dst_blocks  Luma blocks (1, 2 or 4 of them depending on the
+        ///                    MCU layout) followed by Cb and Cr blocks.
+        /// \retval            true on success.
+        /// \retval            false on failure.
+        bool decode_mcu(JpegReader& reader, int (&dst_blocks)[6][64], uint32_t mcu_idx) noexcept;
+
+        /// \brief Decodes DC DCT coefficients of all blocks of a minimum coded unit (MCU) by its index.
+        ///
+        /// \param dst_dc_coeffs  DC DCT coefficients of luma blocks (1, 2 or 4
+        ///                       of them depending on the MCU layout) followed
+        ///                       by those of Cb and Cr blocks.
+        /// \retval               true on success.
+        /// \retval               false on failure.
+        ///
+        /// Same as decode_mcu, except that AC DCT coefficients are read through
+        /// symbol by symbol without decoding.
+        bool decode_mcu_dc(JpegReader& reader, int (&dst_dc_coeffs)[6], uint32_t mcu_idx) noexcept;
 
     private:
 
+        // index of the next block in the ECS, be it luma or chroma
         uint32_t m_block_idx {};
-        uint32_t m_luma_block_idx {};
-        int m_previous_luma_dc_coeff {};
+
+        // DC DCT coefficients of the last Y', Cb and Cr blocks read
+        int m_previous_dc_coeffs[3] {};
+
+        // scan layout (see set_dc_scan)
+        bool m_is_dc_scan {false};
+        uint8_t m_point_transform {};
+
+        // MCU layout (see set_mcu_layout)
+        bool m_is_grayscale {false};
+        uint8_t m_mcu_width_blk {1};
+        uint8_t m_mcu_height_blk {1};
+        uint8_t m_mcu_luma_blocks_count {1};
+        uint16_t m_width_mcu {};
+
+        // decoding state at the start of an MCU row, allows going back within the row without restarting the ECS
+        struct Checkpoint {
+            JpegReader::EcsPosition position {};
+            uint32_t block_idx {UINT32_MAX};
+            int previous_dc_coeffs[3] {};
+        } m_row_checkpoint {};
+
+        // index of the first block of the next MCU row in the ECS
+        uint32_t m_next_row_block_idx {};
+
+        // maximum count of MCUs per row indexed for 2 rows of luma blocks per MCU (1600 px wide frames with 4:2:0 chroma subsampling)
+        static constexpr uint16_t MAX_INDEXED_MCUS = 100;
+
+        // decoding states at the first block of the second row of luma blocks of every MCU of the current MCU row,
+        // allows decoding the second row of blocks of an MCU row without reading through the first one again
+        struct {
+            JpegReader::EcsPosition position {};
+            int previous_dc_coeffs[3] {};
+        } m_lower_blocks_index[MAX_INDEXED_MCUS] {};
+
+        uint16_t m_indexed_mcus_count {};
 
         struct HuffmanTable {
 
-            explicit HuffmanTable (uint16_t* const codes_buff) :
-                codes(codes_buff)
+            HuffmanTable (uint8_t* const histogram_buff, uint8_t* const symbols_buff, uint16_t* const codes_buff) :
+                histogram(histogram_buff),
+                symbols(symbols_buff),
+                codes(codes_buff),
+                histogram_buff(histogram_buff),
+                symbols_buff(symbols_buff),
+                codes_buff(codes_buff)
                 {}
 
             const uint8_t* histogram {nullptr};
             const uint8_t* symbols {nullptr};
-            uint16_t* const codes {nullptr};
+            const uint16_t* codes {nullptr};
+
+            // storage for copies of the table last set by set_htable and its generated codes, kept across clear()
+            uint8_t* const histogram_buff {nullptr};
+            uint8_t* const symbols_buff {nullptr};
+            uint16_t* const codes_buff {nullptr};
+
+            // symbols count of the copy, 0 if none
+            uint8_t buff_symbols_count {};
 
             bool is_set {false};
         };
@@ -57,9 +168,11 @@ class Huffman {
         struct StaticHuffmanTable : public HuffmanTable {
 
             StaticHuffmanTable() :
-                HuffmanTable(&codes_buff[0])
+                HuffmanTable(&histogram_buff[0], &symbols_buff[0], &codes_buff[0])
                 {}
 
+            uint8_t histogram_buff[16] {};
+            uint8_t symbols_buff[size] {};
             uint16_t codes_buff[size] {};
         };
 
@@ -93,6 +206,32 @@ class Huffman {
         // decodes next block from the ECS, be it luma or chroma (specified via `table_id`)
         bool decode_next_block(JpegReader& reader, int (&dst_block)[64], uint8_t table_id) const noexcept;
 
+        // decodes only DC DCT coefficient of next block from the ECS, reads through the rest of the block symbol by symbol
+        bool skip_next_block(JpegReader& reader, int& dc_coeff, uint8_t table_id) const noexcept;
+
+        // reads through blocks up to the one specified by its index in the ECS (going back to the MCU row checkpoint or restarting the ECS if already beyond)
+        bool skip_to_block(JpegReader& reader, uint32_t block_idx) noexcept;
+
+        // decodes next block from the ECS including DC prediction
+        bool decode_predicted_block(JpegReader& reader, int (&dst_block)[64]) noexcept;
+
+        // decodes a block of a grayscale frame by its index in the ECS (reading through preceding blocks, restarting the ECS if already beyond)
+        bool decode_grayscale_block(JpegReader& reader, int (&dst_block)[64], uint32_t block_idx) noexcept;
+
+        // stores the MCU row checkpoint if the next block to read starts a new MCU row, indexes lower luma blocks of MCUs
+        void update_row_checkpoint(const JpegReader& reader) noexcept;
+
+        // moves straight to the MCU's lower luma blocks if the requested block is one of them and indexed
+        bool seek_lower_blocks(JpegReader& reader, uint32_t block_idx) noexcept;
+
+        // component (0 for Y', 1 for Cb, 2 for Cr) of a block by its index in the ECS
+        uint8_t get_component(const uint32_t block_idx) const noexcept {
+
+            const uint8_t mcu_block_idx = block_idx % (2 + m_mcu_luma_blocks_count);
+
+            return mcu_block_idx < m_mcu_luma_blocks_count ? 0 : mcu_block_idx - m_mcu_luma_blocks_count + 1;
+        }
+
         uint8_t get_symbol(JpegReader& reader, uint8_t table_id, uint8_t is_ac) const noexcept;
 
         static int16_t get_dct_coeff(JpegReader& reader, uint8_t length) noexcept;
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Implements BlockWriter for block-wise writing with integral downscaling.
+///
+/// \tparam FACTOR  Downscaling factor, one of 2, 4 or 8 (for 2:1, 4:1 or 8:1).
+///
+/// Specialized alternative to DownscalingBlockWriter for the common case of
+/// downscaling both dimensions by the same power of two. Since the factor
+/// divides the block size, every input block maps onto a whole number of
+/// output pixels so no partial values are ever carried over between blocks and
+/// all math is done in integers.
+template <uint8_t FACTOR>
+class IntegralDownscalingBlockWriter final : public BlockWriter {
+
+    static_assert(FACTOR == 2 || FACTOR == 4 || FACTOR == 8, "downscaling factor must be one of 2, 4 or 8");
+
+    public:
+
+        /// Width and height of the output area corresponding to a single input block.
+        static constexpr uint DST_BLOCK_SIZE = 8 / FACTOR;
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Raw pixel buffer for writing output to, minimum
+        ///                       size is `(src_width_px / FACTOR) * (src_height_px / FACTOR)`
+        ///                       unless set otherwise by set_dst_layout().
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written to destination
+        /// buffer.
+        void init(uint8_t* const dst, const uint16_t src_width_px, [[maybe_unused]] const uint16_t src_height_px) noexcept override {
+
+            init_dst(dst, src_width_px / FACTOR);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+        }
+
+        /// \brief Performs a single block write with integral downscaling.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// Each call performs an unbuffered write of `(8 / FACTOR) * (8 / FACTOR)`
+        /// output pixels, each being the rounded average of the corresponding
+        /// `FACTOR * FACTOR` group of input block pixels.
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        void write(int (&src_block)[64]) noexcept override {
+
+            uint8_t dst_block[DST_BLOCK_SIZE * DST_BLOCK_SIZE];
+            downscale_block(src_block, dst_block);
+
+            uint8_t* dst = m_dst + (m_block_y / FACTOR) * m_dst_pitch_px + m_block_x / FACTOR;
+            uint src_idx = 0;
+
+            for (uint dst_row = 0; dst_row < DST_BLOCK_SIZE; ++dst_row) {
+
+                for (uint dst_col = 0; dst_col < DST_BLOCK_SIZE; ++dst_col) {
+
+                    dst[dst_col] = dst_block[src_idx++];
+                }
+
+                dst += m_dst_pitch_px;
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+        /// \brief Downscales a single block.
+        ///
+        /// \param src_block  Input block.
+        /// \param dst_block  Output block, `DST_BLOCK_SIZE * DST_BLOCK_SIZE`
+        ///                   pixels in raster order.
+        ///
+        /// Every output pixel is the rounded average of the corresponding
+        /// `FACTOR * FACTOR` group of input block pixels. Exposed for other
+        /// writers that downscale before rearranging the output.
+        ///
+        /// \par Implementation Details
+        /// Input rows are first summed vertically in groups of \c FACTOR, then
+        /// the resulting row sums are summed horizontally. Both passes run over
+        /// fixed-size arrays with compile-time trip counts so that the compiler
+        /// can unroll and vectorize them for the target at hand.
+        static void downscale_block(const int (&src_block)[64], uint8_t (&dst_block)[DST_BLOCK_SIZE * DST_BLOCK_SIZE]) noexcept {
+
+            // vertical sums of src block columns, one row per dst row
+            int column_sums[DST_BLOCK_SIZE][8] {};
+
+            for (uint dst_row = 0; dst_row < DST_BLOCK_SIZE; ++dst_row) {
+
+                for (uint i = 0; i < FACTOR; ++i) {
+
+                    const int* const src_row = &src_block[(dst_row * FACTOR + i) * 8];
+
+                    for (uint col = 0; col < 8; ++col) {
+
+                        column_sums[dst_row][col] += src_row[col];
+                    }
+                }
+            }
+
+            uint dst_idx = 0;
+
+            for (uint dst_row = 0; dst_row < DST_BLOCK_SIZE; ++dst_row) {
+
+                for (uint dst_col = 0; dst_col < DST_BLOCK_SIZE; ++dst_col) {
+
+                    int sum = 0;
+
+                    for (uint i = 0; i < FACTOR; ++i) {
+
+                        sum += column_sums[dst_row][dst_col * FACTOR + i];
+                    }
+
+                    // range-normalized input guarantees the average fits in `uint8_t`
+                    dst_block[dst_idx++] = (sum + AREA / 2) / AREA;
+                }
+            }
+        }
+
+    private:
+
+        // count of src pixels contributing to a single dst pixel
+        static constexpr uint AREA = FACTOR * FACTOR;
+};
+
+}  // namespace mdjpeg
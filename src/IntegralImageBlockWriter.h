@@ -0,0 +1,289 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Implements BlockWriter for computing the integral image (summed-area table) of luma.
+///
+/// Produces a table of `(src_width_px + 1) * (src_height_px + 1)` sums, stored
+/// in raster order and tightly packed, where the entry at (\c x, \c y) is the
+/// sum of all pixels of the region of interest above and to the left of pixel
+/// (\c x, \c y), exclusive. The first row and the first column of the table are
+/// therefore zero and the sum of any rectangle of pixels takes four lookups.
+/// Optionally, also produces the integral image of squared pixel values (e.g.
+/// for variance normalization of box features) in the same layout.
+///
+/// Supports cropping (see BlockWriter::set_src_window), tables are then
+/// produced for the window of pixels only, with dimensions above referring to
+/// the window.
+///
+/// \note Output is written to the tables registered by set_tables(), never to
+/// the destination passed to init() which may therefore be \c nullptr. The
+/// destination layout set by BlockWriter::set_dst_layout is ignored. Sums
+/// overflow unless the region of interest has no more than 16843009 pixels
+/// (e.g. 4096x4096).
+class IntegralImageBlockWriter final : public BlockWriter {
+
+    public:
+
+        /// \brief Registers output tables for all subsequent regions of interest.
+        ///
+        /// \param sums          Table of sums, minimum size is
+        ///                      `(src_width_px + 1) * (src_height_px + 1)`
+        ///                      (the size of the window if cropping).
+        /// \param squared_sums  Table of sums of squares, minimum size as above,
+        ///                      \c nullptr to disable.
+        ///
+        /// Takes effect on the next call to init().
+        void set_tables(uint32_t* const sums, uint64_t* const squared_sums = nullptr) noexcept {
+
+            m_sums = sums;
+            m_squared_sums = squared_sums;
+        }
+
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Ignored.
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written. Zeroes the first
+        /// row of the tables.
+        void init([[maybe_unused]] uint8_t* const dst, const uint16_t src_width_px, const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+
+            for (uint i = 0; i <= m_src_window.width_px; ++i) {
+
+                m_sums[i] = 0;
+            }
+
+            if (m_squared_sums) {
+
+                for (uint i = 0; i <= m_src_window.width_px; ++i) {
+
+                    m_squared_sums[i] = 0;
+                }
+            }
+        }
+
+        /// \brief Accumulates a single block into the tables.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// Each call performs an unbuffered write of the 8x8 table entries to
+        /// the right of and below the input block's top left pixel (those of
+        /// its pixels within the window if cropping).
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        ///
+        /// \par Implementation Details
+        /// Every table entry is the entry directly above it plus the running
+        /// sum of its pixel row. Running row sums are carried over from block
+        /// to block across each band of 8 pixel rows and the row of entries
+        /// above a band is read back from the table itself, which thus serves
+        /// as the column-sum carry between bands. Decoded pixels are never
+        /// stored.
+        void write(int (&src_block)[64]) noexcept override {
+
+            const uint32_t pitch = m_src_window.width_px + 1;
+            const BlockSpan span = clip_block();
+
+            if (m_block_x == 0) {
+
+                for (uint row = 0; row < 8; ++row) {
+
+                    m_row_sums[row] = 0;
+                    m_row_squared_sums[row] = 0;
+                }
+
+                // first column of the table, rows of the band within the window
+                for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                    m_sums[(m_block_y + row - m_src_window.y_px + 1) * pitch] = 0;
+                }
+
+                if (m_squared_sums) {
+
+                    for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                        m_squared_sums[(m_block_y + row - m_src_window.y_px + 1) * pitch] = 0;
+                    }
+                }
+            }
+
+            if (!span.is_empty()) {
+
+                if (m_squared_sums) {
+
+                    accumulate<true>(src_block, span, pitch);
+                }
+
+                else {
+
+                    accumulate<false>(src_block, span, pitch);
+                }
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+        /// \brief Accumulates a whole band of 8 pixel rows into the tables.
+        ///
+        /// \param src_rows      Input band, 8 rows of `src_width_px` pixels each,
+        ///                      stored contiguously.
+        /// \param src_width_px  Width of the region of interest expressed in pixels.
+        ///
+        /// Each call writes 8 complete rows of table entries (rows within the
+        /// window if cropping), each in a single sequential sweep, which is
+        /// friendlier to caches than the 8-entry runs scattered over 8 rows
+        /// written by write().
+        ///
+        /// \note Not to be mixed with write() within the same region of
+        /// interest.
+        void write_rows(const uint8_t* const src_rows, const uint16_t src_width_px) noexcept override {
+
+            // rows of the band within the window
+            const BlockSpan span = clip_block();
+
+            const uint32_t pitch = m_src_window.width_px + 1;
+            const uint8_t* src = src_rows + span.row_begin * src_width_px + m_src_window.x_px;
+            uint32_t offset = (m_block_y + span.row_begin - m_src_window.y_px + 1) * pitch;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                uint32_t* const dst = m_sums + offset;
+                const uint32_t* const above = dst - pitch;
+                uint32_t row_sum = 0;
+
+                dst[0] = 0;
+
+                for (uint col = 0; col < m_src_window.width_px; ++col) {
+
+                    row_sum += src[col];
+                    dst[col + 1] = above[col + 1] + row_sum;
+                }
+
+                if (m_squared_sums) {
+
+                    uint64_t* const squared_dst = m_squared_sums + offset;
+                    const uint64_t* const squared_above = squared_dst - pitch;
+                    uint64_t row_squared_sum = 0;
+
+                    squared_dst[0] = 0;
+
+                    for (uint col = 0; col < m_src_window.width_px; ++col) {
+
+                        row_squared_sum += src[col] * src[col];
+                        squared_dst[col + 1] = squared_above[col + 1] + row_squared_sum;
+                    }
+                }
+
+                src += src_width_px;
+                offset += pitch;
+            }
+
+            m_block_y += 8;
+        }
+
+    private:
+
+        uint32_t* m_sums {nullptr};
+        uint64_t* m_squared_sums {nullptr};
+
+        // running sums of pixel rows of the current band up to the current block
+        uint32_t m_row_sums[8] {};
+        uint64_t m_row_squared_sums[8] {};
+
+        // accumulates pixels of a block within the window into the table(s)
+        template <bool SQUARED>
+        void accumulate(const int (&src_block)[64], const BlockSpan& span, const uint32_t pitch) noexcept {
+
+            // offset of the table entry for the span's top left pixel (its bottom right corner)
+            const uint32_t offset = (m_block_y + span.row_begin - m_src_window.y_px + 1) * pitch
+                                    + m_block_x + span.col_begin - m_src_window.x_px + 1;
+            const uint width = span.col_end - span.col_begin;
+
+            uint32_t* dst = m_sums + offset;
+
+            // formed only along with the squared table, which is null otherwise
+            uint64_t* squared_dst = nullptr;
+
+            if constexpr (SQUARED) {
+
+                squared_dst = m_squared_sums + offset;
+            }
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                // running row sums are staged in locals since table entries may alias the input block
+                uint32_t sums[8];
+                uint64_t squared_sums[8];
+                uint32_t row_sum = m_row_sums[row];
+                uint64_t row_squared_sum = m_row_squared_sums[row];
+
+                for (uint col = 0; col < width; ++col) {
+
+                    const uint32_t value = src_block[row * 8 + span.col_begin + col];
+
+                    row_sum += value;
+                    sums[col] = row_sum;
+
+                    if constexpr (SQUARED) {
+
+                        row_squared_sum += value * value;
+                        squared_sums[col] = row_squared_sum;
+                    }
+                }
+
+                m_row_sums[row] = row_sum;
+                m_row_squared_sums[row] = row_squared_sum;
+
+                const uint32_t* const above = dst - pitch;
+
+                for (uint col = 0; col < width; ++col) {
+
+                    dst[col] = above[col] + sums[col];
+                }
+
+                if constexpr (SQUARED) {
+
+                    const uint64_t* const squared_above = squared_dst - pitch;
+
+                    for (uint col = 0; col < width; ++col) {
+
+                        squared_dst[col] = squared_above[col] + squared_sums[col];
+                    }
+
+                    squared_dst += pitch;
+                }
+
+                dst += pitch;
+            }
+        }
+};
+
+}  // namespace mdjpeg
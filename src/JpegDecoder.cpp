@@ -2,8 +2,10 @@
 
 #include <algorithm>
 
+#include "BlockWriter.h"
 #include "BasicBlockWriter.h"
-#include "transform.h"
+#include "ColorBlockWriter.h"
+#include "RgbBlockWriter.h"
 
 
 using namespace mdjpeg;
@@ -15,6 +17,7 @@ bool JpegDecoder::assign(const uint8_t* const buff, const size_t size) noexcept
     m_dequantizer.clear();
     m_huffman.clear();
     m_frame_info.clear();
+    m_thumbnail = {};
 
     set_state<StateID::ENTRY>();
     m_has_valid_header = parse_header() == StateID::HEADER_OK;
@@ -24,9 +27,29 @@ bool JpegDecoder::assign(const uint8_t* const buff, const size_t size) noexcept
         m_frame_info.clear();
     }
 
+    else {
+
+        m_huffman.set_mcu_layout(m_frame_info.width_px,
+                                 m_frame_info.horiz_chroma_subs_factor,
+                                 m_frame_info.vert_chroma_subs_factor,
+                                 m_frame_info.components_count);
+    }
+
     return m_has_valid_header;
 }
 
+bool JpegDecoder::assign_thumbnail() noexcept {
+
+    const ByteRange thumbnail = get_thumbnail();
+
+    if (!thumbnail.size) {
+
+        return false;
+    }
+
+    return assign(thumbnail.buff, thumbnail.size);
+}
+
 bool JpegDecoder::luma_decode(uint8_t* const dst, const BoundingBox& roi_blk) noexcept {
 
     BasicBlockWriter writer;
@@ -36,25 +59,37 @@ bool JpegDecoder::luma_decode(uint8_t* const dst, const BoundingBox& roi_blk) no
 
 bool JpegDecoder::luma_decode(uint8_t* const dst, const BoundingBox& roi_blk, BlockWriter& writer) noexcept {
 
+    return luma_decode<BlockWriter>(dst, roi_blk, writer);
+}
+
+bool JpegDecoder::luma_decode_px(uint8_t* const dst, const BoundingBox& roi_px) noexcept {
+
+    BasicBlockWriter writer;
+
+    return luma_decode_px(dst, roi_px, writer);
+}
+
+bool JpegDecoder::luma_decode(uint8_t* const dst, const BoundingBox& roi_blk, BlockWriter& writer, uint8_t* const band_buff) noexcept {
+
     if (!m_has_valid_header) {
 
         return false;
     }
 
-    writer.init(dst, 8 * roi_blk.width(), 8 * roi_blk.height());
+    const uint16_t roi_width_px = 8 * roi_blk.width();
 
-    int block_8x8[64] {0};
+    crop_padding(roi_blk, writer);
+    writer.init(dst, roi_width_px, 8 * roi_blk.height());
 
-    const uint16_t src_width_blk = static_cast<uint16_t>(m_frame_info.width_px + 7) / 8;
-    uint32_t row_blk_idx = roi_blk.topleft_Y * src_width_blk + roi_blk.topleft_X;
+    int block_8x8[64] {0};
 
     for (uint16_t row = roi_blk.topleft_Y; row < roi_blk.bottomright_Y; ++row) {
 
-        uint32_t luma_block_idx = row_blk_idx;
+        uint8_t* band_block = band_buff;
 
-        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; ++col, ++luma_block_idx) {
+        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; ++col) {
 
-            if (!m_huffman.decode_luma_block(m_reader, block_8x8, luma_block_idx, m_frame_info.horiz_chroma_subs_factor)) {
+            if (!m_huffman.decode_luma_block(m_reader, block_8x8, col, row)) {
 
                 return false;
             }
@@ -63,10 +98,107 @@ bool JpegDecoder::luma_decode(uint8_t* const dst, const BoundingBox& roi_blk, Bl
             transform::reverse_zig_zag(block_8x8);
             transform::idct(block_8x8);
             transform::range_normalize(block_8x8);
-            writer.write(block_8x8);
+
+            // stage the block at its position within the band
+            uint src_idx = 0;
+
+            for (uint block_row = 0; block_row < 8; ++block_row) {
+
+                for (uint block_col = 0; block_col < 8; ++block_col) {
+
+                    band_block[block_row * roi_width_px + block_col] = block_8x8[src_idx++];
+                }
+            }
+
+            band_block += 8;
         }
 
-        row_blk_idx += src_width_blk;
+        writer.write_rows(band_buff, roi_width_px);
+    }
+
+    return true;
+}
+
+bool JpegDecoder::color_decode(uint8_t* const dst, const BoundingBox& roi_blk) noexcept {
+
+    RgbBlockWriter<PixelFormat::RGB888> writer;
+
+    return color_decode(dst, roi_blk, writer);
+}
+
+bool JpegDecoder::color_decode(uint8_t* const dst, const BoundingBox& roi_blk, ColorBlockWriter& writer) noexcept {
+
+    // grayscale frames have no chroma, the writer is served luma only
+    if (m_frame_info.components_count == 1) {
+
+        return luma_decode<BlockWriter>(dst, roi_blk, writer);
+    }
+
+    const uint8_t cb_qtable_id = m_frame_info.chroma_qtable_ids[0];
+    const uint8_t cr_qtable_id = m_frame_info.chroma_qtable_ids[1];
+
+    if (!m_has_valid_header || !m_dequantizer.is_set(cb_qtable_id) || !m_dequantizer.is_set(cr_qtable_id)) {
+
+        return false;
+    }
+
+    crop_padding(roi_blk, writer);
+    writer.init(dst, 8 * roi_blk.width(), 8 * roi_blk.height());
+
+    const uint8_t horiz_subs_factor = m_frame_info.horiz_chroma_subs_factor;
+    const uint8_t vert_subs_factor = m_frame_info.vert_chroma_subs_factor;
+    const uint8_t mcu_luma_blocks_count = horiz_subs_factor * vert_subs_factor;
+    const uint16_t mcu_width_px = 8 * horiz_subs_factor;
+    const uint16_t width_mcu = (m_frame_info.width_px + mcu_width_px - 1) / mcu_width_px;
+
+    // luma block(s) followed by Cb and Cr blocks of the current MCU
+    int mcu_blocks[6][64] {};
+    int (&cb_block)[64] = mcu_blocks[mcu_luma_blocks_count];
+    int (&cr_block)[64] = mcu_blocks[mcu_luma_blocks_count + 1];
+
+    // chroma blocks upsampled for a single luma block (4:2:2 and 4:2:0 only)
+    int cb_upsampled[64];
+    int cr_upsampled[64];
+
+    uint32_t decoded_mcu_idx = UINT32_MAX;
+
+    for (uint16_t row = roi_blk.topleft_Y; row < roi_blk.bottomright_Y; ++row) {
+
+        const uint8_t mcu_row = row % vert_subs_factor;
+
+        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; ++col) {
+
+            const uint32_t mcu_idx = static_cast<uint32_t>(row / vert_subs_factor) * width_mcu + col / horiz_subs_factor;
+            const uint8_t mcu_col = col % horiz_subs_factor;
+
+            // with 2 rows of luma blocks per MCU, each MCU is decoded once for each of its rows
+            if (mcu_idx != decoded_mcu_idx) {
+
+                if (!m_huffman.decode_mcu(m_reader, mcu_blocks, mcu_idx)) {
+
+                    return false;
+                }
+
+                reconstruct_block(cb_block, cb_qtable_id);
+                reconstruct_block(cr_block, cr_qtable_id);
+                decoded_mcu_idx = mcu_idx;
+            }
+
+            int (&y_block)[64] = mcu_blocks[mcu_row * horiz_subs_factor + mcu_col];
+            reconstruct_block(y_block, 0);
+
+            if (mcu_luma_blocks_count == 1) {
+
+                writer.write(y_block, cb_block, cr_block);
+            }
+
+            else {
+
+                transform::upsample(cb_block, horiz_subs_factor, vert_subs_factor, mcu_col, mcu_row, cb_upsampled);
+                transform::upsample(cr_block, horiz_subs_factor, vert_subs_factor, mcu_col, mcu_row, cr_upsampled);
+                writer.write(y_block, cb_upsampled, cr_upsampled);
+            }
+        }
     }
 
     return true;
@@ -81,15 +213,10 @@ bool JpegDecoder::dc_luma_decode(uint8_t* const dst, const BoundingBox& roi_blk)
    
     int block_8x8[64] {0};
 
-    const uint16_t src_width_blk = static_cast<uint16_t>(m_frame_info.width_px + 7) / 8;
-    uint32_t row_blk_idx = roi_blk.topleft_Y * src_width_blk + roi_blk.topleft_X;
-
     for (uint16_t row = roi_blk.topleft_Y; row < roi_blk.bottomright_Y; ++row) {
 
-        uint32_t luma_block_idx = row_blk_idx;
-
-        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; ++col, ++luma_block_idx) {
-            if (!m_huffman.decode_luma_block(m_reader, block_8x8, luma_block_idx, m_frame_info.horiz_chroma_subs_factor)) {
+        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; ++col) {
+            if (!m_huffman.decode_luma_block(m_reader, block_8x8, col, row)) {
 
                 return false;
             }
@@ -97,18 +224,230 @@ bool JpegDecoder::dc_luma_decode(uint8_t* const dst, const BoundingBox& roi_blk)
             // dequantize only the DC DCT coefficient
             m_dequantizer.transform(block_8x8[0]);
 
-            // recover block-averaged luma value
-            const uint8_t dc_luma = std::min(255u, static_cast<uint>(std::max(0, block_8x8[0] + 1024)) / 8);
+            dst[(row - roi_blk.topleft_Y) * roi_blk.width() + (col - roi_blk.topleft_X)] = dc_to_luma(block_8x8[0]);
+        }
+    }
+
+    return true;
+}
+
+bool JpegDecoder::dc_color_decode(uint8_t* const dst, const BoundingBox& roi_blk, const bool to_ycbcr) noexcept {
+
+    const bool is_grayscale = m_frame_info.components_count == 1;
+    const uint8_t cb_qtable_id = m_frame_info.chroma_qtable_ids[0];
+    const uint8_t cr_qtable_id = m_frame_info.chroma_qtable_ids[1];
+
+    if (!m_has_valid_header || (!is_grayscale && (!m_dequantizer.is_set(cb_qtable_id) || !m_dequantizer.is_set(cr_qtable_id)))) {
+
+        return false;
+    }
+
+    const uint8_t horiz_subs_factor = m_frame_info.horiz_chroma_subs_factor;
+    const uint8_t vert_subs_factor = m_frame_info.vert_chroma_subs_factor;
+    const uint8_t mcu_luma_blocks_count = horiz_subs_factor * vert_subs_factor;
+    const uint16_t mcu_width_px = 8 * horiz_subs_factor;
+    const uint16_t width_mcu = (m_frame_info.width_px + mcu_width_px - 1) / mcu_width_px;
+
+    // DC DCT coefficients of luma block(s) followed by Cb and Cr blocks of the current MCU
+    int mcu_dc_coeffs[6] {};
+    int block_8x8[64] {};
+
+    // block-averaged Y', Cb and Cr values of the current output pixel, chroma is neutral for grayscale frames
+    int y = 0;
+    int cb = 128;
+    int cr = 128;
+
+    uint32_t decoded_mcu_idx = UINT32_MAX;
+    uint8_t* px = dst;
+
+    for (uint16_t row = roi_blk.topleft_Y; row < roi_blk.bottomright_Y; ++row) {
+
+        const uint8_t mcu_row = row % vert_subs_factor;
+
+        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; ++col) {
+
+            if (is_grayscale) {
+
+                if (!m_huffman.decode_luma_block(m_reader, block_8x8, col, row)) {
 
-            dst[(row - roi_blk.topleft_Y) * roi_blk.width() + (col - roi_blk.topleft_X)] = dc_luma;
+                    return false;
+                }
+
+                m_dequantizer.transform(block_8x8[0]);
+                y = dc_to_luma(block_8x8[0]);
+            }
+
+            else {
+
+                const uint32_t mcu_idx = static_cast<uint32_t>(row / vert_subs_factor) * width_mcu + col / horiz_subs_factor;
+
+                // with 2 rows of luma blocks per MCU, each MCU is decoded once for each of its rows
+                if (mcu_idx != decoded_mcu_idx) {
+
+                    if (!m_huffman.decode_mcu_dc(m_reader, mcu_dc_coeffs, mcu_idx)) {
+
+                        return false;
+                    }
+
+                    m_dequantizer.transform(mcu_dc_coeffs[mcu_luma_blocks_count], cb_qtable_id);
+                    m_dequantizer.transform(mcu_dc_coeffs[mcu_luma_blocks_count + 1], cr_qtable_id);
+                    cb = dc_to_luma(mcu_dc_coeffs[mcu_luma_blocks_count]);
+                    cr = dc_to_luma(mcu_dc_coeffs[mcu_luma_blocks_count + 1]);
+                    decoded_mcu_idx = mcu_idx;
+                }
+
+                int y_dc_coeff = mcu_dc_coeffs[mcu_row * horiz_subs_factor + col % horiz_subs_factor];
+                m_dequantizer.transform(y_dc_coeff);
+                y = dc_to_luma(y_dc_coeff);
+            }
+
+            if (to_ycbcr) {
+
+                px[0] = y;
+                px[1] = cb;
+                px[2] = cr;
+            }
+
+            else {
+
+                transform::ycbcr_to_rgb888(&y, &cb, &cr, px, 1);
+            }
+
+            px += 3;
+        }
+    }
+
+    return true;
+}
+
+bool JpegDecoder::strided_luma_decode(uint8_t* const dst, const BoundingBox& roi_blk, const uint8_t stride) noexcept {
+
+    BasicBlockWriter writer;
+
+    return strided_luma_decode(dst, roi_blk, stride, writer);
+}
+
+bool JpegDecoder::strided_luma_decode(uint8_t* const dst, const BoundingBox& roi_blk, const uint8_t stride, BlockWriter& writer) noexcept {
+
+    if (!m_has_valid_header || !stride) {
+
+        return false;
+    }
+
+    // dimensions of the compacted grid of sample blocks
+    const uint16_t samples_width_blk = (roi_blk.width() + stride - 1) / stride;
+    const uint16_t samples_height_blk = (roi_blk.height() + stride - 1) / stride;
+
+    writer.init(dst, 8 * samples_width_blk, 8 * samples_height_blk);
+
+    int block_8x8[64] {0};
+
+    for (uint16_t row = roi_blk.topleft_Y; row < roi_blk.bottomright_Y; row += stride) {
+
+        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; col += stride) {
+
+            // blocks in between are skipped over by Huffman decoder
+            if (!m_huffman.decode_luma_block(m_reader, block_8x8, col, row)) {
+
+                return false;
+            }
+
+            m_dequantizer.transform(block_8x8);
+            transform::reverse_zig_zag(block_8x8);
+            transform::idct(block_8x8);
+            transform::range_normalize(block_8x8);
+            writer.write(block_8x8);
         }
+    }
+
+    return true;
+}
+
+bool JpegDecoder::foveated_luma_decode(uint8_t* const dc_dst,
+                                       const BoundingBox* const rois_blk,
+                                       BlockWriter* const* const writers,
+                                       uint8_t* const* const dsts,
+                                       const uint8_t rois_count) noexcept {
+
+    if (!m_has_valid_header) {
+
+        return false;
+    }
+
+    for (uint i = 0; i < rois_count; ++i) {
 
-        row_blk_idx += src_width_blk;
+        crop_padding(rois_blk[i], *writers[i]);
+        writers[i]->init(dsts[i], 8 * rois_blk[i].width(), 8 * rois_blk[i].height());
+    }
+
+    int block_8x8[64] {0};
+    int block_copy[64];
+
+    const uint16_t src_width_blk = static_cast<uint16_t>(m_frame_info.width_px + 7) / 8;
+    const uint16_t src_height_blk = static_cast<uint16_t>(m_frame_info.height_px + 7) / 8;
+    uint32_t luma_block_idx = 0;
+
+    for (uint16_t row = 0; row < src_height_blk; ++row) {
+
+        for (uint16_t col = 0; col < src_width_blk; ++col, ++luma_block_idx) {
+
+            if (!m_huffman.decode_luma_block(m_reader, block_8x8, col, row)) {
+
+                return false;
+            }
+
+            // regions of interest the block belongs to, the last one of them receives the original block
+            uint8_t last_roi_idx = rois_count;
+
+            for (uint i = 0; i < rois_count; ++i) {
+
+                if (rois_blk[i].contains(col, row)) {
+
+                    last_roi_idx = i;
+                }
+            }
+
+            if (last_roi_idx == rois_count) {
+
+                // dequantize only the DC DCT coefficient
+                m_dequantizer.transform(block_8x8[0]);
+                dc_dst[luma_block_idx] = dc_to_luma(block_8x8[0]);
+
+                continue;
+            }
+
+            m_dequantizer.transform(block_8x8);
+            dc_dst[luma_block_idx] = dc_to_luma(block_8x8[0]);
+
+            transform::reverse_zig_zag(block_8x8);
+            transform::idct(block_8x8);
+            transform::range_normalize(block_8x8);
+
+            for (uint i = 0; i < last_roi_idx; ++i) {
+
+                if (rois_blk[i].contains(col, row)) {
+
+                    // writers may modify their input
+                    std::copy(block_8x8, block_8x8 + 64, block_copy);
+                    writers[i]->write(block_copy);
+                }
+            }
+
+            writers[last_roi_idx]->write(block_8x8);
+        }
     }
 
     return true;
 }
 
+void JpegDecoder::reconstruct_block(int (&block)[64], const uint8_t qtable_id) const noexcept {
+
+    m_dequantizer.transform(block, qtable_id);
+    transform::reverse_zig_zag(block);
+    transform::idct(block);
+    transform::range_normalize(block);
+}
+
 StateID JpegDecoder::parse_header() noexcept {
 
     while (!m_istate->is_final_state()) {
@@ -119,9 +458,15 @@ StateID JpegDecoder::parse_header() noexcept {
     return m_istate->getID();
 }
 
-void JpegDecoder::FrameInfo::set(const uint16_t height_px, const uint16_t width_px, const uint8_t horiz_chroma_subs_factor) noexcept {
+void JpegDecoder::FrameInfo::set(const uint16_t height_px,
+                                  const uint16_t width_px,
+                                  const uint8_t horiz_chroma_subs_factor,
+                                  const uint8_t vert_chroma_subs_factor,
+                                  const uint8_t components_count) noexcept {
 
     this->height_px = height_px;
     this->width_px = width_px;
     this->horiz_chroma_subs_factor = horiz_chroma_subs_factor;
+    this->vert_chroma_subs_factor = vert_chroma_subs_factor;
+    this->components_count = components_count;
 }
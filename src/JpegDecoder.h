@@ -3,17 +3,20 @@
 #include <stdint.h>
 #include <sys/types.h>
 #include <new>
+#include <algorithm>
 
 #include "states.h"
 #include "JpegReader.h"
 #include "Huffman.h"
 #include "Dequantizer.h"
 #include "BoundingBox.h"
+#include "transform.h"
 
 
 namespace mdjpeg {
 
 class BlockWriter;
+class ColorBlockWriter;
 
 
 /// \brief Decoder class for JPEG File Interchange Format (JFIF) data.
@@ -26,16 +29,26 @@ class BlockWriter;
 /// for the whole region of interest. Does not allocate memory on the heap.
 ///
 /// \note
-/// - Supported mode is baseline JPEG.
-/// - Supported color space is Y'CbCr.
-/// - Supported chroma subsampling schemes are 4:4:4 and 4:2:2.
-/// - Both spacial image dimensions must be multiples of 8 pixels.
-/// - Region of interest must be defined using (8x8) blocks, not pixels.
-/// - Output is luma channel only.
+/// - Supported mode is baseline JPEG. Of progressive JPEG, only the first DC
+///   scan is decoded, meant for dc_luma_decode (see is_progressive).
+/// - Supported color spaces are Y'CbCr and grayscale (single component).
+/// - Supported chroma subsampling schemes are 4:4:4, 4:2:2 and 4:2:0.
+/// - Spacial image dimensions need not be multiples of 8 pixels. Partial
+///   blocks on the right and bottom edge of the frame are served to writers
+///   whole, with padding pixels cropped at write time (see luma_decode).
+/// - Region of interest is defined using (8x8) blocks, or using pixels with
+///   writers that support cropping (see luma_decode_px).
+/// - Output is luma channel only, except for color_decode and dc_color_decode.
 class JpegDecoder {
 
     public:
 
+        /// \brief View on a range of bytes within the assigned memory block.
+        struct ByteRange {
+            const uint8_t* buff {nullptr};
+            size_t size {};
+        };
+
         /// \brief Sets its view on a block of compressed image data.
         ///
         /// \param buff  Start of memory block containing JFIF data.
@@ -47,8 +60,12 @@ class JpegDecoder {
         /// JFIF header succeeds. Entropy-coded segment is not read during
         /// assignment.
         ///
-        /// \attention No data copying or ownership transfer takes place. The
-        /// caller is responsible for
+        /// Quantization and %Huffman tables are copied from the JFIF header.
+        /// Tables identical to those of the previously assigned frame, as in
+        /// MJPEG streams, are reused without rebuilding %Huffman codes.
+        ///
+        /// \attention Apart from the tables, no data copying or ownership
+        /// transfer takes place. The caller is responsible for
         /// - image data integrity for as long as it needs JpegDecoder to
         /// operate on it
         /// - making sure that the memory is not leaked afterwards (if allocated
@@ -70,12 +87,63 @@ class JpegDecoder {
             return m_has_valid_header ? m_frame_info.height_px : 0;
         }
 
+        /// \brief Queries whether the frame is progressive as read from the JFIF header.
+        ///
+        /// \return  true if JFIF header is valid and describes a progressive frame, false otherwise.
+        ///
+        /// Only the first DC scan of progressive frames is decoded, so all
+        /// their blocks are flat. dc_luma_decode yields the same 1:8 scaled-down
+        /// image as for baseline frames (up to the precision of the scan), all
+        /// other decompression modes yield blocky previews.
+        bool is_progressive() const noexcept {
+
+            return m_has_valid_header && m_frame_info.is_progressive;
+        }
+
+        /// \brief Queries the JPEG thumbnail embedded in EXIF metadata (\e APP1 segment) as read from the JFIF header.
+        ///
+        /// \return  Byte range of the thumbnail's JFIF data within the assigned
+        ///          memory block if JFIF header is valid and the thumbnail is
+        ///          present, empty range otherwise.
+        ///
+        /// The thumbnail is found through the \c JPEGInterchangeFormat and
+        /// \c JPEGInterchangeFormatLength tags of IFD1 (the second image file
+        /// directory of EXIF metadata). It can be decompressed by any
+        /// JpegDecoder, see assign_thumbnail.
+        ByteRange get_thumbnail() const noexcept {
+
+            return m_has_valid_header ? m_thumbnail : ByteRange {};
+        }
+
+        /// \brief Sets its view on the embedded JPEG thumbnail, if present.
+        ///
+        /// \retval  true on success.
+        /// \retval  false on failure, including no thumbnail present.
+        ///
+        /// Equivalent to calling assign() with the range returned by
+        /// get_thumbnail(), i.e. all subsequent decompression applies to the
+        /// thumbnail rather than the main image. Decompressing the thumbnail
+        /// (typically 160x120 pixels) is far cheaper than even DC-only
+        /// decompression of the main image. The same \attention notes as for
+        /// assign() apply to the memory block of the main image. Calling
+        /// assign() with the main image afterwards switches back to it.
+        bool assign_thumbnail() noexcept;
+
         /// \brief Decompresses the luma channel, writing to raw pixel buffer via BasicBlockWriter by default.
         ///
-        /// \param dst     Raw pixel buffer for decompressed output, min size is `64 * (x2_blk - x1_blk) * (y2_blk - y1_blk)`.
+        /// \param dst     Raw pixel buffer for decompressed output, min size is `64 * (x2_blk - x1_blk) * (y2_blk - y1_blk)`
+        ///                less the padding pixels of partial blocks on the frame edges (see below).
         /// \param roi_blk Coordinates for the region of interest expressed in 8x8 blocks.
         /// \retval        true on success.
         /// \retval        false on failure.
+        ///
+        /// For frames with dimensions that are not multiples of 8 pixels, the
+        /// rightmost column and the bottom row of blocks are partial, i.e.
+        /// padded by the encoder. Regions of interest including them are
+        /// cropped to the frame, so the output is `min(8 * x2_blk, width_px) - 8 * x1_blk`
+        /// pixels wide and similarly high. The same applies to all other
+        /// decompression modes with a full scale output, provided that the
+        /// writer supports cropping (see BlockWriter::supports_cropping).
         bool luma_decode(uint8_t* dst, const BoundingBox& roi_blk) noexcept;
 
         /// \brief Decompresses the luma channel writing to raw pixel buffer via specified BlockWriter.
@@ -87,14 +155,176 @@ class JpegDecoder {
         /// \retval        false on failure.
         bool luma_decode(uint8_t* dst, const BoundingBox& roi_blk, BlockWriter& writer) noexcept;
 
+        /// \brief Decompresses the luma channel writing to raw pixel buffer via statically known writer.
+        ///
+        /// \tparam Writer  Type of the writer, BlockWriter or any of its implementations.
+        /// \param dst      Raw pixel buffer for decompressed output, min size depending on particular writer.
+        /// \param roi_blk  Coordinates for the region of interest expressed in 8x8 blocks.
+        /// \param writer   Specific implementation to use for writing decompressed data to raw pixel buffer.
+        /// \retval         true on success.
+        /// \retval         false on failure.
+        ///
+        /// Preferred by overload resolution whenever the concrete type of the
+        /// writer is known at the call site. Calls to \c writer are then
+        /// dispatched statically (for BlockWriter implementations that are
+        /// marked \c final) which allows the compiler to inline the writer
+        /// into the decoding loop. The overload taking a BlockWriter reference
+        /// is kept for dynamic dispatch.
+        template <class Writer>
+        bool luma_decode(uint8_t* dst, const BoundingBox& roi_blk, Writer& writer) noexcept;
+
+        /// \brief Decompresses the luma channel writing to raw pixel buffer via specified BlockWriter band by band.
+        ///
+        /// \param dst        Raw pixel buffer for decompressed output, min size depending on particular BlockWriter.
+        /// \param roi_blk    Coordinates for the region of interest expressed in 8x8 blocks.
+        /// \param writer     Specific implementation to use for writing decompressed data to raw pixel buffer.
+        /// \param band_buff  Staging buffer, min size is `64 * (x2_blk - x1_blk)`.
+        /// \retval           true on success.
+        /// \retval           false on failure.
+        ///
+        /// Each row of blocks of the region of interest is first decompressed
+        /// into \c band_buff and then handed over to the writer in a single
+        /// BlockWriter::write_rows call.
+        bool luma_decode(uint8_t* dst, const BoundingBox& roi_blk, BlockWriter& writer, uint8_t* band_buff) noexcept;
+
+        /// \brief Decompresses the luma channel of a pixel-accurate region of interest via BasicBlockWriter by default.
+        ///
+        /// \param dst     Raw pixel buffer for decompressed output, min size is `(x2_px - x1_px) * (y2_px - y1_px)`.
+        /// \param roi_px  Coordinates for the region of interest expressed in pixels.
+        /// \retval        true on success.
+        /// \retval        false on failure.
+        bool luma_decode_px(uint8_t* dst, const BoundingBox& roi_px) noexcept;
+
+        /// \brief Decompresses the luma channel of a pixel-accurate region of interest via specified writer.
+        ///
+        /// \tparam Writer  Type of the writer, BlockWriter or any of its implementations.
+        /// \param dst      Raw pixel buffer for decompressed output, min size depending on particular writer.
+        /// \param roi_px   Coordinates for the region of interest expressed in pixels.
+        /// \param writer   Specific implementation to use for writing decompressed data to raw pixel buffer.
+        /// \retval         true on success.
+        /// \retval         false on failure, including empty region of interest,
+        ///                 one exceeding image dimensions or a writer that does
+        ///                 not support cropping (see BlockWriter::supports_cropping).
+        ///
+        /// Decompresses the blocks enclosing the region of interest and
+        /// registers the region's position within them with the writer (see
+        /// BlockWriter::set_src_window), which then discards the pixels outside
+        /// of it at write time. No intermediate buffer is involved and the
+        /// output is exactly the size of the region of interest.
+        template <class Writer>
+        bool luma_decode_px(uint8_t* dst, const BoundingBox& roi_px, Writer& writer) noexcept;
+
+        /// \brief Decompresses all channels, writing RGB888 pixels to raw pixel buffer via RgbBlockWriter by default.
+        ///
+        /// \param dst     Raw pixel buffer for decompressed output, min size is `3 * 64 * (x2_blk - x1_blk) * (y2_blk - y1_blk)`.
+        /// \param roi_blk Coordinates for the region of interest expressed in 8x8 (luma) blocks.
+        /// \retval        true on success.
+        /// \retval        false on failure.
+        bool color_decode(uint8_t* dst, const BoundingBox& roi_blk) noexcept;
+
+        /// \brief Decompresses all channels writing to raw pixel buffer via specified ColorBlockWriter.
+        ///
+        /// \param dst     Raw pixel buffer for decompressed output, min size depending on particular ColorBlockWriter.
+        /// \param roi_blk Coordinates for the region of interest expressed in 8x8 (luma) blocks.
+        /// \param writer  Specific implementation to use for writing decompressed data to raw pixel buffer.
+        /// \retval        true on success.
+        /// \retval        false on failure, including chroma quantization tables missing or not supported.
+        ///
+        /// Every minimum coded unit overlapping the region of interest is
+        /// decoded once for each of its rows of luma blocks (i.e. twice for
+        /// 4:2:0 chroma subsampling, unless cut by the region of interest). Its
+        /// chroma blocks are reconstructed using their own quantization tables
+        /// and, for 4:2:2 and 4:2:0 chroma subsampling, upsampled for each of
+        /// its luma blocks within the region of interest (see
+        /// transform::upsample). Every luma block is then handed over to the
+        /// writer together with its chroma blocks. Grayscale frames are
+        /// decompressed as by luma_decode, i.e. the writer is served luma
+        /// blocks only.
+        bool color_decode(uint8_t* dst, const BoundingBox& roi_blk, ColorBlockWriter& writer) noexcept;
+
         /// \brief Decompresses 1:8 scaled-down luma channel to raw pixel buffer using DC DCT coefficients only.
         ///
         /// \param dst     Raw pixel buffer for decompressed output, min size is `(x2_blk - x1_blk) * (y2_blk - y1_blk)`.
         /// \param roi_blk Coordinates for the region of interest expressed in 8x8 blocks.
         /// \retval        true on success.
         /// \retval        false on failure.
+        ///
+        /// Partial blocks on the frame edges yield an output pixel each, i.e.
+        /// the output of the whole frame is `ceil(width_px / 8)` pixels wide
+        /// and `ceil(height_px / 8)` pixels high. Their values include the
+        /// padding pixels (usually replicated edge pixels).
+        ///
+        /// \note Progressive frames are supported, their first DC scan holds
+        /// everything this mode needs (see is_progressive).
         bool dc_luma_decode(uint8_t* dst, const BoundingBox& roi_blk) noexcept;
 
+        /// \brief Decompresses 1:8 scaled-down color image to raw pixel buffer using DC DCT coefficients only.
+        ///
+        /// \param dst       Raw pixel buffer for decompressed output, min size is `3 * (x2_blk - x1_blk) * (y2_blk - y1_blk)`.
+        /// \param roi_blk   Coordinates for the region of interest expressed in 8x8 (luma) blocks.
+        /// \param to_ycbcr  Whether to output Y'CbCr triplets instead of RGB888 (red first).
+        /// \retval          true on success.
+        /// \retval          false on failure, including chroma quantization tables missing or not supported.
+        ///
+        /// Same as dc_luma_decode, every luma block yields an output pixel. Its
+        /// chroma is the block-averaged chroma of its minimum coded unit, i.e.
+        /// chroma is replicated into 2 (4:2:2) or 4 (4:2:0) adjacent output
+        /// pixels. No %IDCT is computed, DC DCT coefficients of all components
+        /// are dequantized and the AC ones are read through without decoding,
+        /// so the cost is close to that of dc_luma_decode. RGB888 output uses
+        /// the same conversion as color_decode. Grayscale frames yield neutral
+        /// chroma.
+        bool dc_color_decode(uint8_t* dst, const BoundingBox& roi_blk, bool to_ycbcr = false) noexcept;
+
+        /// \brief Decompresses a sparse grid of sample blocks of the luma channel, writing to raw pixel buffer via BasicBlockWriter by default.
+        ///
+        /// \param dst      Raw pixel buffer for decompressed output, min size is `64 * ceil((x2_blk - x1_blk) / stride) * ceil((y2_blk - y1_blk) / stride)`.
+        /// \param roi_blk  Coordinates for the region of interest expressed in 8x8 blocks.
+        /// \param stride   Distance between sample blocks expressed in blocks, both horizontally and vertically.
+        /// \retval         true on success.
+        /// \retval         false on failure, including zero \c stride.
+        bool strided_luma_decode(uint8_t* dst, const BoundingBox& roi_blk, uint8_t stride) noexcept;
+
+        /// \brief Decompresses a sparse grid of sample blocks of the luma channel via specified BlockWriter.
+        ///
+        /// \param dst      Raw pixel buffer for decompressed output, min size depending on particular BlockWriter.
+        /// \param roi_blk  Coordinates for the region of interest expressed in 8x8 blocks.
+        /// \param stride   Distance between sample blocks expressed in blocks, both horizontally and vertically.
+        /// \param writer   Specific implementation to use for writing decompressed data to raw pixel buffer.
+        /// \retval         true on success.
+        /// \retval         false on failure, including zero \c stride.
+        ///
+        /// Only every \c stride-th block of every \c stride-th row of blocks,
+        /// starting with the top left block of the region of interest, is
+        /// fully decompressed. Sample blocks are handed over to the writer as
+        /// if they were adjacent, i.e. the writer is initialized with the
+        /// dimensions of the compacted grid of samples. All other blocks are
+        /// read through symbol by symbol without decoding their coefficients
+        /// (except DC ones needed for prediction), dequantization or IDCT.
+        /// Sample blocks are always served whole, including the padding
+        /// pixels of partial blocks on the frame edges.
+        bool strided_luma_decode(uint8_t* dst, const BoundingBox& roi_blk, uint8_t stride, BlockWriter& writer) noexcept;
+
+        /// \brief Decompresses 1:8 scaled-down luma channel of the whole frame and full resolution luma channel of selected regions in a single pass.
+        ///
+        /// \param dc_dst      Raw pixel buffer for the scaled-down output, min size is `width_blk * height_blk` of the whole frame.
+        /// \param rois_blk    Coordinates for the regions of interest expressed in 8x8 blocks, \c rois_count elements.
+        /// \param writers     Specific implementations to use for writing each region of interest, \c rois_count elements.
+        /// \param dsts        Raw pixel buffers for each region of interest, \c rois_count elements, min sizes depending on particular BlockWriter.
+        /// \param rois_count  Count of regions of interest.
+        /// \retval            true on success.
+        /// \retval            false on failure.
+        ///
+        /// Blocks within any of the regions of interest are fully decompressed
+        /// and handed over to the writers of all the regions they belong to
+        /// (regions may overlap). All other blocks contribute only their DC
+        /// DCT coefficient, exactly as in dc_luma_decode. The scaled-down
+        /// output covers the whole frame, including the regions of interest.
+        /// The entropy-coded segment is traversed only once. Regions of
+        /// interest including partial blocks on the frame edges are cropped as
+        /// by luma_decode.
+        bool foveated_luma_decode(uint8_t* dc_dst, const BoundingBox* rois_blk, BlockWriter* const* writers, uint8_t* const* dsts, uint8_t rois_count) noexcept;
+
         template <StateID ANY>
         friend class ConcreteState;
 
@@ -105,8 +335,12 @@ class JpegDecoder {
             uint16_t height_px {};
             uint16_t width_px {};
             uint8_t  horiz_chroma_subs_factor {};
+            uint8_t  vert_chroma_subs_factor {};
+            uint8_t  components_count {};      // 1 (grayscale) or 3 (Y'CbCr)
+            uint8_t  chroma_qtable_ids[2] {};  // Cb, Cr
+            bool     is_progressive {};        // set by SOF2 state, only the first DC scan is decoded
 
-            void set(uint16_t height_px, uint16_t width_px, uint8_t horiz_chroma_subs_factor) noexcept;
+            void set(uint16_t height_px, uint16_t width_px, uint8_t horiz_chroma_subs_factor, uint8_t vert_chroma_subs_factor, uint8_t components_count) noexcept;
 
             bool is_set() const noexcept {
 
@@ -118,10 +352,18 @@ class JpegDecoder {
                 height_px = 0;
                 width_px = 0;
                 horiz_chroma_subs_factor = 0;
+                vert_chroma_subs_factor = 0;
+                components_count = 0;
+                chroma_qtable_ids[0] = 0;
+                chroma_qtable_ids[1] = 0;
+                is_progressive = false;
             };
 
         } m_frame_info {};
 
+        // JFIF data of the JPEG thumbnail embedded in EXIF metadata, set by APP1 state
+        ByteRange m_thumbnail {};
+
         // indication of successful assignment
         bool m_has_valid_header {false};
 
@@ -133,9 +375,22 @@ class JpegDecoder {
 
         // misc decoding utilities
         JpegReader m_reader {};        // 4 x ptr + 1 uint8
-        Dequantizer m_dequantizer {};  // 1 ptr
+        Dequantizer m_dequantizer {};  // 4 x ptr + 4 x 64 uint8
         Huffman m_huffman {};          // large object (keep it last)
 
+        // limits the window of the writer to the pixels of the region of interest within the frame
+        template <class Writer>
+        void crop_padding(const BoundingBox& roi_blk, Writer& writer) const noexcept;
+
+        // dequantizes a block of DCT coefficients and reconstructs its pixels (in place)
+        void reconstruct_block(int (&block)[64], uint8_t qtable_id) const noexcept;
+
+        // recover block-averaged luma (or chroma) value from dequantized DC DCT coefficient
+        static uint8_t dc_to_luma(const int dc_coeff) noexcept {
+
+            return std::min(255u, static_cast<uint>(std::max(0, dc_coeff + 1024)) / 8);
+        }
+
         // step function for the state machine that parses JFIF header
         StateID parse_header() noexcept;
 
@@ -147,4 +402,72 @@ class JpegDecoder {
         }
 };
 
+template <class Writer>
+bool JpegDecoder::luma_decode(uint8_t* const dst, const BoundingBox& roi_blk, Writer& writer) noexcept {
+
+    if (!m_has_valid_header) {
+
+        return false;
+    }
+
+    crop_padding(roi_blk, writer);
+    writer.init(dst, 8 * roi_blk.width(), 8 * roi_blk.height());
+
+    int block_8x8[64] {0};
+
+    for (uint16_t row = roi_blk.topleft_Y; row < roi_blk.bottomright_Y; ++row) {
+
+        for (uint16_t col = roi_blk.topleft_X; col < roi_blk.bottomright_X; ++col) {
+
+            if (!m_huffman.decode_luma_block(m_reader, block_8x8, col, row)) {
+
+                return false;
+            }
+
+            m_dequantizer.transform(block_8x8);
+            transform::reverse_zig_zag(block_8x8);
+            transform::idct(block_8x8);
+            transform::range_normalize(block_8x8);
+            writer.write(block_8x8);
+        }
+    }
+
+    return true;
+}
+
+template <class Writer>
+bool JpegDecoder::luma_decode_px(uint8_t* const dst, const BoundingBox& roi_px, Writer& writer) noexcept {
+
+    if (!m_has_valid_header || !writer.supports_cropping()
+        || roi_px.bottomright_X <= roi_px.topleft_X || roi_px.bottomright_X > m_frame_info.width_px
+        || roi_px.bottomright_Y <= roi_px.topleft_Y || roi_px.bottomright_Y > m_frame_info.height_px) {
+
+        return false;
+    }
+
+    // blocks enclosing the region of interest
+    const BoundingBox roi_blk {static_cast<uint16_t>(roi_px.topleft_X / 8),
+                               static_cast<uint16_t>(roi_px.topleft_Y / 8),
+                               static_cast<uint16_t>((roi_px.bottomright_X + 7) / 8),
+                               static_cast<uint16_t>((roi_px.bottomright_Y + 7) / 8)};
+
+    writer.set_src_window(roi_px.topleft_X % 8, roi_px.topleft_Y % 8, roi_px.width(), roi_px.height());
+
+    return luma_decode(dst, roi_blk, writer);
+}
+
+template <class Writer>
+void JpegDecoder::crop_padding(const BoundingBox& roi_blk, Writer& writer) const noexcept {
+
+    const uint32_t x2_px = 8u * roi_blk.bottomright_X;
+    const uint32_t y2_px = 8u * roi_blk.bottomright_Y;
+
+    // partial blocks on the right and bottom frame edges are padded beyond them
+    if (x2_px > m_frame_info.width_px || y2_px > m_frame_info.height_px) {
+
+        writer.limit_src_window(std::min<uint32_t>(x2_px, m_frame_info.width_px) - 8 * roi_blk.topleft_X,
+                                std::min<uint32_t>(y2_px, m_frame_info.height_px) - 8 * roi_blk.topleft_Y);
+    }
+}
+
 }  // namespace mdjpeg
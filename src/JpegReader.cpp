@@ -154,3 +154,37 @@ int8_t JpegReader::read_bit() noexcept {
     // almost never reached (unless ECS is corrupted)
     return ReadError::ECS_BIT;
 }
+
+bool JpegReader::skip_bits(uint8_t count) noexcept {
+
+    while (count) {
+
+        // entering a new byte, let read_bit validate it
+        if (m_current_bit_pos == 7) {
+
+            if (read_bit() == ReadError::ECS_BIT) {
+
+                return false;
+            }
+
+            --count;
+            continue;
+        }
+
+        // bits left in an already validated byte
+        const uint8_t bits_available = m_current_bit_pos + 1;
+
+        if (count < bits_available) {
+
+            m_current_bit_pos -= count;
+
+            return true;
+        }
+
+        count -= bits_available;
+        ++m_buff_current_byte;
+        m_current_bit_pos = 7;
+    }
+
+    return true;
+}
@@ -14,6 +14,12 @@ class JpegReader {
 
     public:
 
+        /// \brief Cursor position within ECS, down to a single bit.
+        struct EcsPosition {
+            const uint8_t* byte {nullptr};
+            uint8_t bit_pos {};
+        };
+
         /// \brief Sets its view on the JFIF data memory block.
         ///
         /// \param buff  Start of memory block containing JFIF data.
@@ -26,6 +32,19 @@ class JpegReader {
         /// \brief Restores the cursor position to the start of ECS.
         void restart_ecs() noexcept;
 
+        /// \brief Accessor for the cursor position within ECS.
+        EcsPosition tell_ecs_position() const noexcept {
+
+            return {m_buff_current_byte, m_current_bit_pos};
+        }
+
+        /// \brief Restores the cursor position within ECS previously obtained by tell_ecs_position().
+        void seek_ecs_position(const EcsPosition& position) noexcept {
+
+            m_buff_current_byte = position.byte;
+            m_current_bit_pos = position.bit_pos;
+        }
+
         /// \brief Computes the size in bytes of the buffer available after the cursor.
         size_t size_remaining() const noexcept {
 
@@ -64,6 +83,16 @@ class JpegReader {
         /// \return  Bit value on success, ReadError::ECS_BIT otherwise.
         int8_t read_bit() noexcept;
 
+        /// \brief Advances the cursor by a number of bits, applying rules for reading ECS.
+        ///
+        /// \param count  Number of bits to skip.
+        /// \retval       true on success.
+        /// \retval       false on failure, i.e. whenever read_bit() would have failed.
+        ///
+        /// Equivalent to calling read_bit() \c count times but only validates
+        /// bytes that are entered rather than extracting every single bit.
+        bool skip_bits(uint8_t count) noexcept;
+
     private:
 
         const uint8_t* m_buff_start {nullptr};
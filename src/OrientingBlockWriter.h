@@ -0,0 +1,252 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <utility>
+
+#include "BlockWriter.h"
+#include "IntegralDownscalingBlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Output orientation relative to the region of interest.
+///
+/// Values match those of the EXIF Orientation tag. Rotations are clockwise.
+enum class Orientation : uint8_t {
+    NORMAL = 1,
+    MIRROR_HORIZONTAL = 2,
+    ROTATE_180 = 3,
+    MIRROR_VERTICAL = 4,
+    TRANSPOSE = 5,
+    ROTATE_90 = 6,
+    TRANSVERSE = 7,
+    ROTATE_270 = 8
+};
+
+/// \brief Implements BlockWriter for block-wise writing with rotation or mirroring.
+///
+/// \tparam ORIENTATION  Output orientation.
+/// \tparam FACTOR       Integral downscaling factor, one of 1, 2, 4 or 8 (1 for no downscaling).
+///
+/// Every input block is placed directly at its rotated and/or mirrored
+/// position in the destination buffer, so no separate pass over the decoded
+/// frame is needed. With \c FACTOR other than 1 every input block is
+/// downscaled first, exactly as by IntegralDownscalingBlockWriter<FACTOR>.
+///
+/// Output dimensions are `(src_width_px / FACTOR) x (src_height_px / FACTOR)`
+/// for orientations 1 through 4 and `(src_height_px / FACTOR) x (src_width_px / FACTOR)`
+/// for orientations 5 through 8. See get_dst_width_px() and get_dst_height_px().
+///
+/// Supports cropping (see BlockWriter::set_src_window), output is then written
+/// for the window of pixels only, so that padding pixels of partial blocks on
+/// the right and bottom frame edges never end up on the left or top edge of
+/// mirrored or transposed output. With \c FACTOR other than 1, the window is
+/// extended to position and dimensions that are multiples of \c FACTOR first,
+/// so that every output pixel downscales whole `FACTOR x FACTOR` cells. Output
+/// dimensions above then refer to the (extended) window.
+template <Orientation ORIENTATION, uint8_t FACTOR = 1>
+class OrientingBlockWriter final : public BlockWriter {
+
+    static_assert(FACTOR == 1 || FACTOR == 2 || FACTOR == 4 || FACTOR == 8, "downscaling factor must be one of 1, 2, 4 or 8");
+
+    public:
+
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Raw pixel buffer for writing output to, minimum
+        ///                       size is `(src_width_px / FACTOR) * (src_height_px / FACTOR)`
+        ///                       (the extended window if cropping) unless set
+        ///                       otherwise by set_dst_layout().
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written to destination
+        /// buffer.
+        void init(uint8_t* const dst, const uint16_t src_width_px, const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            align_src_window(FACTOR);
+
+            m_dst_width_px = (TRANSPOSED ? m_src_window.height_px : m_src_window.width_px) / FACTOR;
+            m_dst_height_px = (TRANSPOSED ? m_src_window.width_px : m_src_window.height_px) / FACTOR;
+
+            init_dst(dst, m_dst_width_px);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+        }
+
+        /// \brief Performs a single block write with rotation or mirroring.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// Each call performs an unbuffered write of up to `(8 / FACTOR) * (8 / FACTOR)`
+        /// output pixels (within the window if cropping) to the area of
+        /// destination buffer the input block maps onto.
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        ///
+        /// \par Implementation Details
+        /// Orientations are decomposed into an optional transposition followed
+        /// by optional mirroring of output columns and/or rows, all resolved at
+        /// compile time. The (downscaled) block is rearranged into output order
+        /// by a fixed-size loop with constant source indices, then its part
+        /// within the window is written row by row with the destination
+        /// pointer advancing forwards only.
+        void write(int (&src_block)[64]) noexcept override {
+
+            const BlockSpan span = clip_block();
+
+            if (!span.is_empty()) {
+
+                write_span(span, src_block);
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+        /// \brief Accessor for output width of the current region of interest.
+        uint16_t get_dst_width_px() const noexcept {
+
+            return m_dst_width_px;
+        }
+
+        /// \brief Accessor for output height of the current region of interest.
+        uint16_t get_dst_height_px() const noexcept {
+
+            return m_dst_height_px;
+        }
+
+    private:
+
+        // width and height of the dst area corresponding to a single src block
+        static constexpr uint BLOCK_SIZE = 8 / FACTOR;
+        static constexpr uint BLOCK_AREA = BLOCK_SIZE * BLOCK_SIZE;
+
+        // decomposition of orientation: transposition first, then mirroring of dst columns and/or rows
+        static constexpr bool TRANSPOSED = ORIENTATION == Orientation::TRANSPOSE
+                                           || ORIENTATION == Orientation::ROTATE_90
+                                           || ORIENTATION == Orientation::TRANSVERSE
+                                           || ORIENTATION == Orientation::ROTATE_270;
+
+        static constexpr bool MIRRORED_COLS = ORIENTATION == Orientation::MIRROR_HORIZONTAL
+                                              || ORIENTATION == Orientation::ROTATE_180
+                                              || ORIENTATION == Orientation::ROTATE_90
+                                              || ORIENTATION == Orientation::TRANSVERSE;
+
+        static constexpr bool MIRRORED_ROWS = ORIENTATION == Orientation::ROTATE_180
+                                              || ORIENTATION == Orientation::MIRROR_VERTICAL
+                                              || ORIENTATION == Orientation::TRANSVERSE
+                                              || ORIENTATION == Orientation::ROTATE_270;
+
+        uint16_t m_dst_width_px {};
+        uint16_t m_dst_height_px {};
+
+        // writes (downscaled) pixels of the current block within the window, all of the span's bounds are multiples of FACTOR since the window's are
+        void write_span(const BlockSpan& span, const int (&src_block)[64]) noexcept {
+
+            // src block in raster order, downscaled if requested
+            uint8_t block[BLOCK_AREA];
+
+            if constexpr (FACTOR == 1) {
+
+                for (uint i = 0; i < BLOCK_AREA; ++i) {
+
+                    block[i] = src_block[i];
+                }
+            }
+
+            else {
+
+                IntegralDownscalingBlockWriter<FACTOR>::downscale_block(src_block, block);
+            }
+
+            // block rearranged in dst order
+            uint8_t oriented[BLOCK_AREA];
+
+            for (uint row = 0; row < BLOCK_SIZE; ++row) {
+
+                for (uint col = 0; col < BLOCK_SIZE; ++col) {
+
+                    const uint unmirrored_row = MIRRORED_ROWS ? BLOCK_SIZE - 1 - row : row;
+                    const uint unmirrored_col = MIRRORED_COLS ? BLOCK_SIZE - 1 - col : col;
+
+                    oriented[row * BLOCK_SIZE + col] = TRANSPOSED ? block[unmirrored_col * BLOCK_SIZE + unmirrored_row]
+                                                                  : block[unmirrored_row * BLOCK_SIZE + unmirrored_col];
+                }
+            }
+
+            // span within the (downscaled) block and within the (downscaled) window, half-open ranges
+            uint col1 = span.col_begin / FACTOR;
+            uint col2 = span.col_end / FACTOR;
+            uint row1 = span.row_begin / FACTOR;
+            uint row2 = span.row_end / FACTOR;
+            uint x1 = (m_block_x + span.col_begin - m_src_window.x_px) / FACTOR;
+            uint x2 = (m_block_x + span.col_end - m_src_window.x_px) / FACTOR;
+            uint y1 = (m_block_y + span.row_begin - m_src_window.y_px) / FACTOR;
+            uint y2 = (m_block_y + span.row_end - m_src_window.y_px) / FACTOR;
+
+            // same ranges within the oriented block and within dst
+            if constexpr (TRANSPOSED) {
+
+                std::swap(col1, row1);
+                std::swap(col2, row2);
+                std::swap(x1, y1);
+                std::swap(x2, y2);
+            }
+
+            if constexpr (MIRRORED_COLS) {
+
+                const uint mirrored_col1 = BLOCK_SIZE - col2;
+                const uint mirrored_x1 = m_dst_width_px - x2;
+
+                col2 = BLOCK_SIZE - col1;
+                x2 = m_dst_width_px - x1;
+                col1 = mirrored_col1;
+                x1 = mirrored_x1;
+            }
+
+            if constexpr (MIRRORED_ROWS) {
+
+                const uint mirrored_row1 = BLOCK_SIZE - row2;
+                const uint mirrored_y1 = m_dst_height_px - y2;
+
+                row2 = BLOCK_SIZE - row1;
+                y2 = m_dst_height_px - y1;
+                row1 = mirrored_row1;
+                y1 = mirrored_y1;
+            }
+
+            uint8_t* dst = m_dst + y1 * m_dst_pitch_px + x1;
+
+            for (uint row = row1; row < row2; ++row) {
+
+                const uint8_t* const src = &oriented[row * BLOCK_SIZE];
+
+                for (uint col = col1; col < col2; ++col) {
+
+                    dst[col - col1] = src[col];
+                }
+
+                dst += m_dst_pitch_px;
+            }
+        }
+};
+
+}  // namespace mdjpeg
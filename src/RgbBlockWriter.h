@@ -0,0 +1,158 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "ColorBlockWriter.h"
+#include "transform.h"
+
+
+namespace mdjpeg {
+
+/// \brief Pixel formats of RgbBlockWriter output.
+enum class PixelFormat : uint8_t {
+    RGB888,  ///< 3 bytes per pixel, red first
+    RGB565   ///< 16-bit value per pixel in native byte order, red in the most significant bits
+};
+
+/// \brief Implements ColorBlockWriter for block-wise writing of RGB pixels in 1:1 scale.
+///
+/// \tparam FORMAT  Output pixel format.
+///
+/// Y'CbCr input is converted by the fixed-point kernels of
+/// transform::ycbcr_to_rgb888 and transform::ycbcr_to_rgb565. Luma-only input
+/// (see BlockWriter::write) produces grayscale output.
+///
+/// Supports cropping (see BlockWriter::set_src_window), output is then
+/// written for the window of pixels only.
+///
+/// \note Destination layout set by BlockWriter::set_dst_layout is expressed in
+/// pixels, not bytes. Output in RGB565 format requires destination aligned to
+/// 2 bytes.
+template <PixelFormat FORMAT>
+class RgbBlockWriter final : public ColorBlockWriter {
+
+    public:
+
+        /// \brief Size of an output pixel in bytes.
+        static constexpr uint8_t PX_SIZE = FORMAT == PixelFormat::RGB888 ? 3 : 2;
+
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Raw buffer for writing output to, minimum size
+        ///                       is `PX_SIZE * src_width_px * src_height_px` bytes
+        ///                       (the size of the window if cropping) unless set
+        ///                       otherwise by set_dst_layout().
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written to destination
+        /// buffer.
+        void init(uint8_t* const dst, const uint16_t src_width_px, const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            init_dst(dst, m_src_window.width_px, PX_SIZE);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+        }
+
+        /// \brief Performs a single block write of grayscale pixels.
+        ///
+        /// \param src_block  Input luma block.
+        ///
+        /// Each call performs an unbuffered write of all input block pixels
+        /// (within the window if cropping) to destination buffer.
+        void write(int (&src_block)[64]) noexcept override {
+
+            const BlockSpan span = clip_block();
+            const uint count = span.col_end - span.col_begin;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                uint8_t* const dst = get_dst_row(row, span.col_begin);
+
+                for (uint col = 0; col < count; ++col) {
+
+                    const int y = src_block[8 * row + span.col_begin + col];
+
+                    if constexpr (FORMAT == PixelFormat::RGB888) {
+
+                        dst[3 * col] = y;
+                        dst[3 * col + 1] = y;
+                        dst[3 * col + 2] = y;
+                    }
+
+                    else {
+
+                        reinterpret_cast<uint16_t*>(dst)[col] = (y & 0xf8) << 8 | (y & 0xfc) << 3 | y >> 3;
+                    }
+                }
+            }
+
+            advance_block();
+        }
+
+        /// \brief Performs a single block write of color pixels.
+        ///
+        /// \param y_block   Input luma block.
+        /// \param cb_block  Input Cb block, upsampled to luma resolution.
+        /// \param cr_block  Input Cr block, upsampled to luma resolution.
+        ///
+        /// Each call performs an unbuffered write of all input block pixels
+        /// (within the window if cropping) to destination buffer, converting
+        /// them one block row at a time.
+        void write(int (&y_block)[64], int (&cb_block)[64], int (&cr_block)[64]) noexcept override {
+
+            const BlockSpan span = clip_block();
+            const uint count = span.col_end - span.col_begin;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                const uint offset = 8 * row + span.col_begin;
+
+                if constexpr (FORMAT == PixelFormat::RGB888) {
+
+                    transform::ycbcr_to_rgb888(y_block + offset, cb_block + offset, cr_block + offset, get_dst_row(row, span.col_begin), count);
+                }
+
+                else {
+
+                    transform::ycbcr_to_rgb565(y_block + offset, cb_block + offset, cr_block + offset,
+                                               reinterpret_cast<uint16_t*>(get_dst_row(row, span.col_begin)), count);
+                }
+            }
+
+            advance_block();
+        }
+
+    private:
+
+        // position of the current block's pixel at given row and column within dst
+        uint8_t* get_dst_row(const uint row, const uint col) const noexcept {
+
+            return m_dst + ((m_block_y + row - m_src_window.y_px) * m_dst_pitch_px + m_block_x + col - m_src_window.x_px) * PX_SIZE;
+        }
+
+        // advance to the next src block position within the region of interest
+        void advance_block() noexcept {
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+};
+
+}  // namespace mdjpeg
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <cstring>
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Implements BlockWriter for gathering luma statistics without writing any pixels.
+///
+/// Accumulates a 256-bin histogram, sum, sum of squares, minimum and maximum
+/// of all pixels in the region of interest (per-frame granularity).
+/// Optionally, also accumulates all of the above except for the histogram
+/// separately for every tile of a regular grid laid over the region of
+/// interest (per-tile granularity, see set_tiles()).
+///
+/// Supports cropping (see BlockWriter::set_src_window), statistics then cover
+/// the window of pixels only, so that padding pixels of partial blocks on the
+/// right and bottom frame edges are never counted.
+///
+/// \note Nothing is ever written to the destination passed to init() which
+/// may therefore be \c nullptr. The destination layout set by
+/// BlockWriter::set_dst_layout is ignored.
+class StatisticsBlockWriter final : public BlockWriter {
+
+    public:
+
+        /// \brief Accumulated moments and extremes of a set of pixels.
+        struct Moments {
+            uint32_t count {};
+            uint64_t sum {};
+            uint64_t sum_sq {};
+            uint8_t min {255};
+            uint8_t max {0};
+
+            /// \brief Computes the mean pixel value, 0 if empty.
+            float mean() const noexcept {
+
+                return count ? static_cast<float>(sum) / count : 0.0f;
+            }
+
+            /// \brief Computes the (population) variance of pixel values, 0 if empty.
+            float variance() const noexcept {
+
+                if (!count) {
+
+                    return 0.0f;
+                }
+
+                const double mean = static_cast<double>(sum) / count;
+
+                return static_cast<float>(static_cast<double>(sum_sq) / count - mean * mean);
+            }
+
+            /// \brief Resets to empty.
+            void clear() noexcept {
+
+                count = 0;
+                sum = 0;
+                sum_sq = 0;
+                min = 255;
+                max = 0;
+            }
+        };
+
+        /// \brief Accumulated moments, extremes and histogram of a set of pixels.
+        struct Statistics : public Moments {
+            uint32_t histogram[256] {};
+
+            /// \brief Resets to empty.
+            void clear() noexcept {
+
+                Moments::clear();
+                std::memset(histogram, 0, sizeof(histogram));
+            }
+        };
+
+        /// \brief Enables per-tile statistics for all subsequent regions of interest.
+        ///
+        /// \param tiles          Array for per-tile output, minimum size is
+        ///                       `ceil(roi_width_blk / tile_size_blk) * ceil(roi_height_blk / tile_size_blk)`,
+        ///                       \c nullptr to disable.
+        /// \param tile_size_blk  Width and height of a (square) tile expressed in
+        ///                       8x8 blocks, 0 disables per-tile statistics same
+        ///                       as \c nullptr \c tiles.
+        ///
+        /// Tiles are stored in raster order, their grid is aligned to the blocks
+        /// of the region of interest. Tiles along the right and bottom edges of
+        /// the region of interest are smaller if the region's dimensions are
+        /// not multiples of the tile size, tiles hold pixels within the window
+        /// only if cropping. Takes effect on the next call to init().
+        void set_tiles(Moments* const tiles, const uint16_t tile_size_blk) noexcept {
+
+            m_tiles = tile_size_blk ? tiles : nullptr;
+            m_tile_size_px = 8u * tile_size_blk;
+        }
+
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Ignored.
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written. Clears all
+        /// previously accumulated statistics.
+        void init([[maybe_unused]] uint8_t* const dst, const uint16_t src_width_px, const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+
+            m_statistics.clear();
+
+            if (m_tiles) {
+
+                m_width_tiles = (src_width_px + m_tile_size_px - 1) / m_tile_size_px;
+                const uint32_t tiles_count = static_cast<uint32_t>(m_width_tiles) * ((src_height_px + m_tile_size_px - 1) / m_tile_size_px);
+
+                for (uint32_t i = 0; i < tiles_count; ++i) {
+
+                    m_tiles[i].clear();
+                }
+            }
+        }
+
+        /// \brief Accumulates statistics of a single block.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        ///
+        /// \par Implementation Details
+        /// Moments and extremes are first reduced over the block using
+        /// fixed-size loops free of cross-iteration dependencies other than
+        /// the reductions themselves, so that the compiler can vectorize them,
+        /// and only then merged into the accumulated statistics. Blocks only
+        /// partially within the window take a scalar path over their span.
+        void write(int (&src_block)[64]) noexcept override {
+
+            const BlockSpan span = clip_block();
+
+            if (span.is_full()) {
+
+                accumulate_block(src_block);
+            }
+
+            else if (!span.is_empty()) {
+
+                accumulate_span(src_block, span);
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+        /// \brief Accessor for per-frame statistics.
+        ///
+        /// Complete once the last block of the region of interest has been
+        /// written.
+        const Statistics& get_statistics() const noexcept {
+
+            return m_statistics;
+        }
+
+    private:
+
+        Statistics m_statistics {};
+
+        Moments* m_tiles {nullptr};
+        // wide enough for any tile size, including those larger than any region of interest
+        uint32_t m_tile_size_px {8};
+        uint16_t m_width_tiles {};
+
+        // reduces a block wholly within the window
+        void accumulate_block(const int (&src_block)[64]) noexcept {
+
+            int block_sum = 0;
+            int block_sum_sq = 0;
+            int block_min = 255;
+            int block_max = 0;
+
+            for (uint i = 0; i < 64; ++i) {
+
+                const int value = src_block[i];
+
+                block_sum += value;
+                block_sum_sq += value * value;
+                block_min = value < block_min ? value : block_min;
+                block_max = value > block_max ? value : block_max;
+            }
+
+            for (uint i = 0; i < 64; ++i) {
+
+                ++m_statistics.histogram[src_block[i]];
+            }
+
+            merge_block(64, block_sum, block_sum_sq, block_min, block_max);
+        }
+
+        // reduces pixels of a block within the window
+        void accumulate_span(const int (&src_block)[64], const BlockSpan& span) noexcept {
+
+            int block_sum = 0;
+            int block_sum_sq = 0;
+            int block_min = 255;
+            int block_max = 0;
+
+            for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                for (uint col = span.col_begin; col < span.col_end; ++col) {
+
+                    const int value = src_block[row * 8 + col];
+
+                    block_sum += value;
+                    block_sum_sq += value * value;
+                    block_min = value < block_min ? value : block_min;
+                    block_max = value > block_max ? value : block_max;
+                    ++m_statistics.histogram[value];
+                }
+            }
+
+            const int count = (span.col_end - span.col_begin) * (span.row_end - span.row_begin);
+
+            merge_block(count, block_sum, block_sum_sq, block_min, block_max);
+        }
+
+        // merges reduced pixels of the current block into per-frame and per-tile statistics
+        void merge_block(const int count, const int sum, const int sum_sq, const int min, const int max) noexcept {
+
+            merge(m_statistics, count, sum, sum_sq, min, max);
+
+            if (m_tiles) {
+
+                const uint32_t tile_idx = static_cast<uint32_t>(m_block_y / m_tile_size_px) * m_width_tiles + m_block_x / m_tile_size_px;
+                merge(m_tiles[tile_idx], count, sum, sum_sq, min, max);
+            }
+        }
+
+        static void merge(Moments& moments, const int count, const int sum, const int sum_sq, const int min, const int max) noexcept {
+
+            moments.count += count;
+            moments.sum += sum;
+            moments.sum_sq += sum_sq;
+            moments.min = min < moments.min ? min : moments.min;
+            moments.max = max > moments.max ? max : moments.max;
+        }
+};
+
+}  // namespace mdjpeg
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "DownscalingBlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Memory layout of a tensor of images.
+enum class TensorLayout : uint8_t {
+    NHWC,  ///< batch, row, column, channel (channels interleaved)
+    NCHW   ///< batch, channel, row, column (channels planar)
+};
+
+/// \brief Output policy of DownscalingBlockWriter for writing model input tensors.
+///
+/// \tparam T              Tensor element type, \c float or an integral type (quantized tensor).
+/// \tparam DST_WIDTH_PX   Width of the tensor's images in pixels.
+/// \tparam DST_HEIGHT_PX  Height of the tensor's images in pixels.
+/// \tparam LAYOUT         Memory layout of the tensor.
+/// \tparam CHANNELS       Count of channels, luma is replicated into all of them.
+///
+/// Every output value \c v (average of contributing input pixels, in range
+/// 0 to 255) is normalized per channel as `x = (v - mean) / std`. Floating
+/// point tensors receive \c x as is, quantized tensors receive
+/// `round(x / scale) + zero_point` saturated to the range of \c T.
+///
+/// \note Output is written to the tensor registered by set_tensor(), never to
+/// the destination passed to DownscalingBlockWriter::init which may therefore
+/// be \c nullptr. The destination layout set by BlockWriter::set_dst_layout is
+/// ignored.
+template <class T, uint16_t DST_WIDTH_PX, uint16_t DST_HEIGHT_PX, TensorLayout LAYOUT, uint8_t CHANNELS>
+class TensorOutput {
+
+    static_assert(std::is_floating_point_v<T> || std::is_integral_v<T>, "tensor element type must be arithmetic");
+    static_assert(CHANNELS > 0, "channels count must be greater than zero");
+
+    public:
+
+        TensorOutput() noexcept {
+
+            for (uint c = 0; c < CHANNELS; ++c) {
+
+                m_std[c] = 1.0f;
+            }
+
+            update_coefficients();
+        }
+
+        /// \brief Registers the tensor to write to.
+        ///
+        /// \param tensor     Tensor of one or more images, minimum size is
+        ///                   `(batch_idx + 1) * CHANNELS * DST_HEIGHT_PX * DST_WIDTH_PX`.
+        /// \param batch_idx  Index of the image (batch slot) to write to.
+        void set_tensor(T* const tensor, const uint16_t batch_idx = 0) noexcept {
+
+            m_tensor = tensor + static_cast<uint32_t>(batch_idx) * IMAGE_SIZE;
+        }
+
+        /// \brief Sets per-channel normalization.
+        ///
+        /// \param mean  Per-channel means, expressed in pixel values (0 to 255).
+        /// \param std   Per-channel standard deviations, expressed in pixel
+        ///              values, must be non-zero.
+        ///
+        /// Defaults to zero means and unit standard deviations (no normalization).
+        void set_normalization(const float (&mean)[CHANNELS], const float (&std)[CHANNELS]) noexcept {
+
+            for (uint c = 0; c < CHANNELS; ++c) {
+
+                m_mean[c] = mean[c];
+                m_std[c] = std[c];
+            }
+
+            update_coefficients();
+        }
+
+        /// \brief Sets quantization parameters, ignored for floating point tensors.
+        ///
+        /// \param scale       Quantization scale, must be non-zero.
+        /// \param zero_point  Quantized value corresponding to zero.
+        ///
+        /// Defaults to unit scale and zero zero-point.
+        void set_quantization(const float scale, const int32_t zero_point) noexcept {
+
+            m_scale = scale;
+            m_zero_point = zero_point;
+            update_coefficients();
+        }
+
+        /// \brief Writes a single output value to all channels of the tensor.
+        ///
+        /// \param dst           Ignored.
+        /// \param dst_pitch_px  Ignored.
+        /// \param x_px          X-coordinate of the output pixel.
+        /// \param y_px          Y-coordinate of the output pixel.
+        /// \param value         Average of contributing input pixels.
+        ///
+        /// \par Implementation Details
+        /// Normalization and quantization are folded into a single precomputed
+        /// affine transform per channel, so each element takes one multiply-add
+        /// (plus rounding and saturation for quantized tensors).
+        void write([[maybe_unused]] uint8_t* const dst, [[maybe_unused]] const uint32_t dst_pitch_px,
+                   const uint16_t x_px, const uint16_t y_px, const float value) const noexcept {
+
+            const uint32_t pixel_idx = static_cast<uint32_t>(y_px) * DST_WIDTH_PX + x_px;
+
+            for (uint c = 0; c < CHANNELS; ++c) {
+
+                const float x = value * m_gain[c] + m_offset[c];
+                const uint32_t idx = LAYOUT == TensorLayout::NHWC ? pixel_idx * CHANNELS + c
+                                                                  : c * PLANE_SIZE + pixel_idx;
+
+                if constexpr (std::is_floating_point_v<T>) {
+
+                    m_tensor[idx] = x;
+                }
+
+                else {
+
+                    const long q = std::lround(x);
+                    m_tensor[idx] = q < MIN ? MIN : (q > MAX ? MAX : q);
+                }
+            }
+        }
+
+    private:
+
+        static constexpr uint32_t PLANE_SIZE = static_cast<uint32_t>(DST_WIDTH_PX) * DST_HEIGHT_PX;
+        static constexpr uint32_t IMAGE_SIZE = PLANE_SIZE * CHANNELS;
+        static constexpr long MIN = std::numeric_limits<T>::lowest();
+        static constexpr long MAX = std::numeric_limits<T>::max();
+
+        T* m_tensor {nullptr};
+
+        float m_mean[CHANNELS] {};
+        float m_std[CHANNELS] {};
+        float m_scale {1.0f};
+        int32_t m_zero_point {};
+
+        // per-channel affine transform of output values: `x = value * gain + offset`
+        float m_gain[CHANNELS] {};
+        float m_offset[CHANNELS] {};
+
+        void update_coefficients() noexcept {
+
+            const float scale = std::is_floating_point_v<T> ? 1.0f : m_scale;
+            const float zero_point = std::is_floating_point_v<T> ? 0.0f : m_zero_point;
+
+            for (uint c = 0; c < CHANNELS; ++c) {
+
+                m_gain[c] = 1.0f / (m_std[c] * scale);
+                m_offset[c] = zero_point - m_mean[c] * m_gain[c];
+            }
+        }
+};
+
+/// \brief BlockWriter for writing downscaled luma directly into a model input tensor.
+///
+/// \tparam T              Tensor element type, \c float or an integral type (quantized tensor).
+/// \tparam DST_WIDTH_PX   Width of the tensor's images in pixels.
+/// \tparam DST_HEIGHT_PX  Height of the tensor's images in pixels.
+/// \tparam LAYOUT         Memory layout of the tensor.
+/// \tparam CHANNELS       Count of channels, luma is replicated into all of them.
+///
+/// Fuses downscaling (see DownscalingBlockWriter), normalization, quantization
+/// and layout conversion into the decompression pass. Cropping is done by
+/// choosing the region of interest passed to JpegDecoder::luma_decode. The
+/// tensor and its parameters are configured through
+/// DownscalingBlockWriter::get_output (see TensorOutput).
+template <class T, uint16_t DST_WIDTH_PX, uint16_t DST_HEIGHT_PX, TensorLayout LAYOUT = TensorLayout::NHWC, uint8_t CHANNELS = 1>
+using TensorBlockWriter = DownscalingBlockWriter<DST_WIDTH_PX, DST_HEIGHT_PX, TensorOutput<T, DST_WIDTH_PX, DST_HEIGHT_PX, LAYOUT, CHANNELS>>;
+
+}  // namespace mdjpeg
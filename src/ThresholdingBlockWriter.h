@@ -0,0 +1,141 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Implements BlockWriter for block-wise writing of bit-packed binary masks.
+///
+/// Every pixel is compared against a threshold and stored as a single bit,
+/// set for pixels brighter than the threshold. Each 8-pixel row of an input
+/// block is packed into a single byte, the most significant bit holding the
+/// westernmost pixel (same as in PBM images). Output rows are therefore
+/// `src_width_px / 8` bytes long.
+///
+/// The threshold is either global (see set_threshold()) or adaptive, i.e.
+/// computed for every block from its mean (see set_adaptive()).
+///
+/// \note Destination layout set by BlockWriter::set_dst_layout is expressed in
+/// bytes, i.e. in groups of 8 pixels.
+class ThresholdingBlockWriter final : public BlockWriter {
+
+    public:
+
+        /// \brief Sets the global threshold for all subsequent regions of interest.
+        ///
+        /// \param threshold  Pixels brighter than the threshold are set, defaults to 127.
+        ///
+        /// In adaptive mode, the global threshold is used for low-contrast blocks.
+        void set_threshold(const uint8_t threshold) noexcept {
+
+            m_threshold = threshold;
+        }
+
+        /// \brief Enables or disables adaptive thresholding for all subsequent regions of interest.
+        ///
+        /// \param enabled       Whether to threshold every block against its own mean.
+        /// \param offset        Added to the block mean to obtain its threshold.
+        /// \param min_contrast  Blocks with the difference between their brightest
+        ///                      and darkest pixel less than this are considered flat
+        ///                      and thresholded against the global threshold instead.
+        ///
+        /// Disabled by default.
+        void set_adaptive(const bool enabled, const int16_t offset = 0, const uint8_t min_contrast = 0) noexcept {
+
+            m_is_adaptive = enabled;
+            m_offset = offset;
+            m_min_contrast = min_contrast;
+        }
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Raw buffer for writing output to, minimum size
+        ///                       is `(src_width_px / 8) * src_height_px` unless set
+        ///                       otherwise by set_dst_layout().
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written to destination
+        /// buffer.
+        void init(uint8_t* const dst, const uint16_t src_width_px, [[maybe_unused]] const uint16_t src_height_px) noexcept override {
+
+            init_dst(dst, src_width_px / 8);
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+        }
+
+        /// \brief Performs a single block write with thresholding.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// Each call performs an unbuffered write of 8 bytes, one per input
+        /// block row.
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        void write(int (&src_block)[64]) noexcept override {
+
+            int threshold = m_threshold;
+
+            if (m_is_adaptive) {
+
+                int sum = 0;
+                int min = 255;
+                int max = 0;
+
+                for (uint i = 0; i < 64; ++i) {
+
+                    const int value = src_block[i];
+
+                    sum += value;
+                    min = value < min ? value : min;
+                    max = value > max ? value : max;
+                }
+
+                if (max - min >= m_min_contrast) {
+
+                    threshold = (sum + 32) / 64 + m_offset;
+                }
+            }
+
+            uint8_t* dst = m_dst + m_block_y * m_dst_pitch_px + m_block_x / 8;
+            uint src_idx = 0;
+
+            for (uint row = 0; row < 8; ++row) {
+
+                uint8_t bits = 0;
+
+                for (uint col = 0; col < 8; ++col) {
+
+                    bits |= (src_block[src_idx++] > threshold) << (7 - col);
+                }
+
+                *dst = bits;
+                dst += m_dst_pitch_px;
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+    private:
+
+        uint8_t m_threshold {127};
+        bool m_is_adaptive {false};
+        int16_t m_offset {};
+        uint8_t m_min_contrast {};
+};
+
+}  // namespace mdjpeg
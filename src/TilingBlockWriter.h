@@ -0,0 +1,189 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "BlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Implements BlockWriter for block-wise writing in tiled memory layout.
+///
+/// \tparam TILE_SIZE_PX  Width and height of a (square) tile in pixels, one of 8, 16 or 32.
+/// \tparam Z_ORDER       Whether tiles are laid out in Z-order (Morton order) rather than in raster order.
+///
+/// Output is a sequence of tiles, each tile being a contiguous
+/// `TILE_SIZE_PX * TILE_SIZE_PX` raster of pixels. Tiles along the right and
+/// bottom edges of the region of interest are padded to full size if the
+/// region's dimensions are not multiples of \c TILE_SIZE_PX (padding pixels
+/// are left untouched). With 8 pixel tiles every input block is written as a
+/// single contiguous 64-byte run.
+///
+/// In Z-order layout tile indices are computed by interleaving the bits of
+/// tile coordinates. Since the region of interest need not be square nor a
+/// power of two tiles across, the layout may contain gaps. See buffer_size().
+///
+/// \note The output is not a raster image, hence the destination layout set
+/// by BlockWriter::set_dst_layout is ignored. Static member functions are
+/// provided for accessing pixels of the tiled output and for converting it to
+/// a raster image.
+template <uint8_t TILE_SIZE_PX = 8, bool Z_ORDER = false>
+class TilingBlockWriter final : public BlockWriter {
+
+    static_assert(TILE_SIZE_PX == 8 || TILE_SIZE_PX == 16 || TILE_SIZE_PX == 32, "tile size must be one of 8, 16 or 32");
+
+    public:
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Raw pixel buffer for writing output to, minimum
+        ///                       size is `buffer_size(src_width_px, src_height_px)`.
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written to destination
+        /// buffer.
+        void init(uint8_t* const dst, const uint16_t src_width_px, [[maybe_unused]] const uint16_t src_height_px) noexcept override {
+
+            m_dst = dst;
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+        }
+
+        /// \brief Performs a single block write.
+        ///
+        /// \param src_block  Input block.
+        ///
+        /// Each call performs an unbuffered write of all input block pixels to
+        /// their tile in destination buffer.
+        ///
+        /// \note Blocks are presumed served in raster order within the region of
+        /// interest.
+        void write(int (&src_block)[64]) noexcept override {
+
+            uint8_t* const dst = m_dst + pixel_offset(m_block_x, m_block_y, m_src_width_px);
+
+            if constexpr (TILE_SIZE_PX == 8) {
+
+                for (uint i = 0; i < 64; ++i) {
+
+                    dst[i] = src_block[i];
+                }
+            }
+
+            else {
+
+                uint src_idx = 0;
+
+                for (uint row = 0; row < 8; ++row) {
+
+                    for (uint col = 0; col < 8; ++col) {
+
+                        dst[row * TILE_SIZE_PX + col] = src_block[src_idx++];
+                    }
+                }
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+        /// \brief Computes the minimum destination buffer size for given region of interest dimensions.
+        ///
+        /// \param width_px   Width of the region of interest expressed in pixels.
+        /// \param height_px  Height of the region of interest expressed in pixels.
+        /// \return           Size in bytes.
+        static uint32_t buffer_size(const uint16_t width_px, const uint16_t height_px) noexcept {
+
+            const uint16_t width_tiles = (width_px + TILE_SIZE_PX - 1) / TILE_SIZE_PX;
+            const uint16_t height_tiles = (height_px + TILE_SIZE_PX - 1) / TILE_SIZE_PX;
+
+            return (tile_index(width_tiles - 1, height_tiles - 1, width_tiles) + 1) * TILE_AREA;
+        }
+
+        /// \brief Computes the offset of a pixel within tiled output.
+        ///
+        /// \param x_px      X-coordinate of the pixel within the region of interest.
+        /// \param y_px      Y-coordinate of the pixel within the region of interest.
+        /// \param width_px  Width of the region of interest expressed in pixels.
+        /// \return          Offset in bytes from the start of tiled output.
+        ///
+        /// Useful for accessing neighbors of a pixel. Pixels within the same
+        /// tile as the one at (\c x_px, \c y_px) can be accessed more cheaply
+        /// relative to its offset, using `TILE_SIZE_PX` as row pitch.
+        static uint32_t pixel_offset(const uint16_t x_px, const uint16_t y_px, const uint16_t width_px) noexcept {
+
+            const uint16_t width_tiles = (width_px + TILE_SIZE_PX - 1) / TILE_SIZE_PX;
+
+            return tile_index(x_px / TILE_SIZE_PX, y_px / TILE_SIZE_PX, width_tiles) * TILE_AREA
+                   + (y_px % TILE_SIZE_PX) * TILE_SIZE_PX
+                   + x_px % TILE_SIZE_PX;
+        }
+
+        /// \brief Converts tiled output to raster image.
+        ///
+        /// \param tiled      Tiled output as written by this writer.
+        /// \param raster     Raw pixel buffer for raster image, minimum size is `width_px * height_px`.
+        /// \param width_px   Width of the region of interest expressed in pixels.
+        /// \param height_px  Height of the region of interest expressed in pixels.
+        static void to_raster(const uint8_t* const tiled, uint8_t* const raster, const uint16_t width_px, const uint16_t height_px) noexcept {
+
+            uint32_t dst_idx = 0;
+
+            for (uint16_t y = 0; y < height_px; ++y) {
+
+                for (uint16_t x = 0; x < width_px; x += TILE_SIZE_PX) {
+
+                    const uint8_t* const src = tiled + pixel_offset(x, y, width_px);
+                    const uint16_t run_length = width_px - x < TILE_SIZE_PX ? width_px - x : TILE_SIZE_PX;
+
+                    for (uint i = 0; i < run_length; ++i) {
+
+                        raster[dst_idx++] = src[i];
+                    }
+                }
+            }
+        }
+
+    private:
+
+        static constexpr uint TILE_AREA = TILE_SIZE_PX * TILE_SIZE_PX;
+
+        // computes the index of a tile from its coordinates
+        static uint32_t tile_index(const uint16_t tile_x, const uint16_t tile_y, const uint16_t width_tiles) noexcept {
+
+            if constexpr (Z_ORDER) {
+
+                return spread_bits(tile_x) | spread_bits(tile_y) << 1;
+            }
+
+            else {
+
+                return static_cast<uint32_t>(tile_y) * width_tiles + tile_x;
+            }
+        }
+
+        // spreads out the bits of a 16-bit value to even bit positions of a 32-bit one
+        static uint32_t spread_bits(const uint16_t value) noexcept {
+
+            uint32_t result = value;
+
+            result = (result | result << 8) & 0x00ff00ff;
+            result = (result | result << 4) & 0x0f0f0f0f;
+            result = (result | result << 2) & 0x33333333;
+            result = (result | result << 1) & 0x55555555;
+
+            return result;
+        }
+};
+
+}  // namespace mdjpeg
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "ColorBlockWriter.h"
+
+
+namespace mdjpeg {
+
+/// \brief Frame formats of YuvBlockWriter output.
+///
+/// All formats use 8-bit samples, Y' followed by Cb (U) and Cr (V) wherever
+/// their order matters.
+enum class YuvFormat : uint8_t {
+    I420,  ///< 4:2:0, planar: Y' plane, then Cb plane, then Cr plane
+    NV12,  ///< 4:2:0, semi-planar: Y' plane, then a single plane of interleaved Cb and Cr
+    YUYV   ///< 4:2:2, packed: `Y0 Cb Y1 Cr` per pair of pixels
+};
+
+/// \brief Implements ColorBlockWriter for block-wise writing of Y'CbCr frames for video encoders.
+///
+/// \tparam FORMAT  Output frame format.
+///
+/// Decoded Y', Cb and Cr samples are written as they are, i.e. without any
+/// color conversion. Chroma served at luma resolution (see ColorBlockWriter)
+/// is subsampled by box averaging, 2x2 samples for 4:2:0 formats and 2x1
+/// samples for YUYV. Since subsampled sources are upsampled by sample
+/// replication, averaging along their subsampled direction is exact: 4:2:0
+/// sources pass through unchanged to 4:2:0 formats, and 4:2:2 to 4:2:0
+/// conversion amounts to averaging of vertically adjacent chroma samples.
+/// Luma-only input (see BlockWriter::write) produces neutral chroma.
+///
+/// Supports cropping (see BlockWriter::set_src_window), output is then written
+/// for the window of pixels only. So that 2x2 chroma cells stay aligned, the
+/// window is extended to even position and dimensions first, i.e. a window
+/// with an odd edge gains the column or row of pixels next to it. In
+/// particular, frames of odd width or height (cropped of their padding by
+/// JpegDecoder) are output with one padding column or row to spare.
+///
+/// For planar and semi-planar formats, planes are stored contiguously and
+/// tightly packed, so a frame of `src_width_px * src_height_px` pixels (the
+/// extended window if cropping) takes `3 * src_width_px * src_height_px / 2`
+/// bytes. YUYV frames take `2 * src_width_px * src_height_px` bytes.
+///
+/// \note Destination layout set by BlockWriter::set_dst_layout is expressed in
+/// pixels and honored for YUYV only. It is ignored for I420 and NV12.
+template <YuvFormat FORMAT>
+class YuvBlockWriter final : public ColorBlockWriter {
+
+    public:
+
+        /// \brief Reports support for cropping (see BlockWriter::supports_cropping).
+        bool supports_cropping() const noexcept override {
+
+            return true;
+        }
+
+        /// \brief Performs initialization.
+        ///
+        /// \param dst            Raw buffer for writing output to, minimum size
+        ///                       depends on the format, see class description.
+        /// \param src_width_px   Width of the region of interest expressed in pixels.
+        /// \param src_height_px  Height of the region of interest expressed in pixels.
+        ///
+        /// It is called before write() is called for the first input block of
+        /// every new region of interest and should not be called again until
+        /// the last block of that region has been written to destination
+        /// buffer.
+        void init(uint8_t* const dst, const uint16_t src_width_px, const uint16_t src_height_px) noexcept override {
+
+            init_src_window(src_width_px, src_height_px);
+            align_src_window(2);
+
+            if constexpr (FORMAT == YuvFormat::YUYV) {
+
+                init_dst(dst, m_src_window.width_px, 2);
+            }
+
+            else {
+
+                const uint32_t luma_size = static_cast<uint32_t>(m_src_window.width_px) * m_src_window.height_px;
+
+                m_dst = dst;
+                m_dst_pitch_px = m_src_window.width_px;
+                m_cb_dst = dst + luma_size;
+                m_cr_dst = FORMAT == YuvFormat::I420 ? m_cb_dst + luma_size / 4 : m_cb_dst + 1;
+            }
+
+            m_src_width_px = src_width_px;
+            m_block_x = 0;
+            m_block_y = 0;
+        }
+
+        /// \brief Performs a single block write of luma with neutral chroma.
+        ///
+        /// \param src_block  Input luma block.
+        ///
+        /// Each call performs an unbuffered write of all input block pixels
+        /// (within the window if cropping) to destination buffer.
+        void write(int (&src_block)[64]) noexcept override {
+
+            static constexpr int NEUTRAL_BLOCK[64] = {
+                128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+                128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+                128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+                128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128
+            };
+
+            write_block(src_block, NEUTRAL_BLOCK, NEUTRAL_BLOCK);
+        }
+
+        /// \brief Performs a single block write of color pixels.
+        ///
+        /// \param y_block   Input luma block.
+        /// \param cb_block  Input Cb block, upsampled to luma resolution.
+        /// \param cr_block  Input Cr block, upsampled to luma resolution.
+        ///
+        /// Each call performs an unbuffered write of all input block pixels
+        /// (within the window if cropping) to destination buffer, i.e. up to
+        /// 8x8 luma samples and either 4x4 (4:2:0) or 4x8 (4:2:2) samples of
+        /// each chroma channel.
+        void write(int (&y_block)[64], int (&cb_block)[64], int (&cr_block)[64]) noexcept override {
+
+            write_block(y_block, cb_block, cr_block);
+        }
+
+    private:
+
+        // Cb and Cr planes (I420) or first Cb and Cr samples of the interleaved plane (NV12)
+        uint8_t* m_cb_dst {nullptr};
+        uint8_t* m_cr_dst {nullptr};
+
+        void write_block(const int (&y_block)[64], const int (&cb_block)[64], const int (&cr_block)[64]) noexcept {
+
+            const BlockSpan span = clip_block();
+
+            if (!span.is_empty()) {
+
+                write_span(span, y_block, cb_block, cr_block);
+            }
+
+            m_block_x += 8;
+
+            if (m_block_x == m_src_width_px) {
+
+                m_block_x = 0;
+                m_block_y += 8;
+            }
+        }
+
+        // writes pixels of the current block within the window, all of the span's bounds are even since the window's are
+        void write_span(const BlockSpan& span, const int (&y_block)[64], const int (&cb_block)[64], const int (&cr_block)[64]) noexcept {
+
+            // position of the span's top left pixel within the window
+            const uint x_px = m_block_x + span.col_begin - m_src_window.x_px;
+            const uint y_px = m_block_y + span.row_begin - m_src_window.y_px;
+            const uint width_px = span.col_end - span.col_begin;
+
+            if constexpr (FORMAT == YuvFormat::YUYV) {
+
+                uint8_t* dst = m_dst + 2 * (y_px * m_dst_pitch_px + x_px);
+
+                for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                    const uint offset = 8 * row + span.col_begin;
+
+                    for (uint col = 0; col < width_px; col += 2) {
+
+                        const uint idx = offset + col;
+
+                        dst[2 * col] = y_block[idx];
+                        dst[2 * col + 1] = (cb_block[idx] + cb_block[idx + 1] + 1) / 2;
+                        dst[2 * col + 2] = y_block[idx + 1];
+                        dst[2 * col + 3] = (cr_block[idx] + cr_block[idx + 1] + 1) / 2;
+                    }
+
+                    dst += 2 * m_dst_pitch_px;
+                }
+            }
+
+            else {
+
+                uint8_t* y_dst = m_dst + y_px * m_dst_pitch_px + x_px;
+
+                for (uint row = span.row_begin; row < span.row_end; ++row) {
+
+                    for (uint col = 0; col < width_px; ++col) {
+
+                        y_dst[col] = y_block[8 * row + span.col_begin + col];
+                    }
+
+                    y_dst += m_dst_pitch_px;
+                }
+
+                // chroma sample step and row pitch of Cb and Cr planes
+                constexpr uint STEP = FORMAT == YuvFormat::NV12 ? 2 : 1;
+                const uint32_t chroma_pitch = STEP * (m_dst_pitch_px / 2);
+                const uint32_t chroma_offset = y_px / 2 * chroma_pitch + STEP * (x_px / 2);
+
+                uint8_t* cb_dst = m_cb_dst + chroma_offset;
+                uint8_t* cr_dst = m_cr_dst + chroma_offset;
+
+                for (uint row = span.row_begin; row < span.row_end; row += 2) {
+
+                    for (uint col = 0; col < width_px; col += 2) {
+
+                        const uint idx = 8 * row + span.col_begin + col;
+
+                        cb_dst[STEP * col / 2] = (cb_block[idx] + cb_block[idx + 1] + cb_block[idx + 8] + cb_block[idx + 9] + 2) / 4;
+                        cr_dst[STEP * col / 2] = (cr_block[idx] + cr_block[idx + 1] + cr_block[idx + 8] + cr_block[idx + 9] + 2) / 4;
+                    }
+
+                    cb_dst += chroma_pitch;
+                    cr_dst += chroma_pitch;
+                }
+            }
+        }
+};
+
+}  // namespace mdjpeg
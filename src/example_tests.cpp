@@ -72,6 +72,16 @@ int main(int argc, char** argv) {
     std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
     total_failed_tests_count += failed_batched_tests_count;
 
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = full_frame_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, odd dimensions (small size, tracked by git)
+    failed_batched_tests_count = full_frame_decoding_tests({151, 101}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
     // synthetic test image (medium size, tracked by git)
     failed_batched_tests_count = full_frame_decoding_tests({800, 800}, test_imgs_dir);
     std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
@@ -85,6 +95,89 @@ int main(int argc, char** argv) {
     // failed_batched_tests_count = full_frame_decoding_tests({1600, 1200}, test_imgs_dir);
     // std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
 
+    // full frame, 1:1 scale, tables reused across frames //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = reused_tables_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = reused_tables_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, 1:1 scale, band-wise //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = full_frame_band_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = full_frame_band_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = full_frame_band_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, band-wise, downscaled via the default band adapter //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = downscaling_band_decoding_test<64, 48>({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = downscaling_band_decoding_test<64, 48>({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = downscaling_band_decoding_test<200, 150>({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, 1:1 scale, tiled //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = tiled_decoding_test<8, false>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += tiled_decoding_test<32, true>({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = tiled_decoding_test<8, true>({800, 800}, test_imgs_dir);
+    failed_batched_tests_count += tiled_decoding_test<32, false>({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, 1:1 scale, filtered //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = filtered_decoding_test<mdjpeg::Filter::GAUSSIAN_5X5>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += filtered_decoding_test<mdjpeg::Filter::SOBEL_MAGNITUDE>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += filtered_decoding_test<mdjpeg::Filter::SOBEL_DIRECTION>({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = filtered_decoding_test<mdjpeg::Filter::GAUSSIAN_5X5>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += filtered_decoding_test<mdjpeg::Filter::SOBEL_MAGNITUDE>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += filtered_decoding_test<mdjpeg::Filter::SOBEL_DIRECTION>({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = filtered_decoding_test<mdjpeg::Filter::GAUSSIAN_5X5>({800, 800}, test_imgs_dir);
+    failed_batched_tests_count += filtered_decoding_test<mdjpeg::Filter::SOBEL_MAGNITUDE>({800, 800}, test_imgs_dir);
+    failed_batched_tests_count += filtered_decoding_test<mdjpeg::Filter::SOBEL_DIRECTION>({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
     // full frame, 1:8 scale (DC-only) //
 
     // synthetic test images (small size, tracked by git)
@@ -92,6 +185,11 @@ int main(int argc, char** argv) {
     std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
     total_failed_tests_count += failed_batched_tests_count;
 
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = full_frame_dc_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
     // synthetic test image (medium size, tracked by git)
     failed_batched_tests_count = full_frame_dc_decoding_tests({800, 800}, test_imgs_dir);
     std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
@@ -105,6 +203,128 @@ int main(int argc, char** argv) {
     // failed_batched_tests_count = full_frame_dc_decoding_tests({1600, 1200}, test_imgs_dir);
     // std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
 
+    // full frame, 1:8 scale (DC-only), color (RGB888 and Y'CbCr) //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = full_frame_dc_color_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = full_frame_dc_color_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = full_frame_dc_color_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame and cropped, 1:1 scale, color (RGB888 and RGB565) //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = color_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = color_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, odd dimensions (small size, tracked by git)
+    failed_batched_tests_count = color_decoding_tests({151, 101}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = color_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, 1:1 scale, Y'CbCr frames (I420, NV12 and YUYV) //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = yuv_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = yuv_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, odd dimensions (small size, tracked by git)
+    failed_batched_tests_count = yuv_decoding_tests({151, 101}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = yuv_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // embedded EXIF thumbnails //
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = thumbnail_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, 1:1 scale, bit-packed binary masks //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = thresholded_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = thresholded_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, statistics only //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = statistics_decoding_tests({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += statistics_decoding_tests({160, 120}, test_imgs_dir, 8192);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = statistics_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = statistics_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, integral image only //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = integral_image_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = integral_image_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = integral_image_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, 1:1 and 1:4 scale in a single pass //
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = composite_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
     // cropped frame, 1:1 scale //
 
     // synthetic test image (medium size, tracked by git)
@@ -112,6 +332,53 @@ int main(int argc, char** argv) {
     std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
     total_failed_tests_count += failed_batched_tests_count;
 
+    // full frame, sparse grid of sample blocks //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = strided_decoding_tests({160, 120}, test_imgs_dir, 3);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = strided_decoding_tests({800, 800}, test_imgs_dir, 4);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    failed_batched_tests_count = strided_decoding_tests({800, 800}, test_imgs_dir, 7);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame 1:8 scale and cropped frames 1:1 scale in a single pass //
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = foveated_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // pixel-accurate cropped frame, 1:1 and adaptive scale in a single pass //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = pixel_cropped_decoding_tests({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = pixel_cropped_decoding_tests({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = pixel_cropped_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // cropped frames assembled into a mosaic, 1:1 scale //
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = mosaic_decoding_tests({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
     // full frame, adaptive scale //
 
     // synthetic test image (medium size, tracked by git)
@@ -119,6 +386,72 @@ int main(int argc, char** argv) {
     std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
     total_failed_tests_count += failed_batched_tests_count;
 
+    // full frame, integral scale //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = integral_downscaling_decoding_test<2>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += integral_downscaling_decoding_test<4>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += integral_downscaling_decoding_test<8>({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = integral_downscaling_decoding_test<2>({800, 800}, test_imgs_dir);
+    failed_batched_tests_count += integral_downscaling_decoding_test<4>({800, 800}, test_imgs_dir);
+    failed_batched_tests_count += integral_downscaling_decoding_test<8>({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, adaptive scale, model input tensors //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = tensor_decoding_test<96, 72>({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = tensor_decoding_test<224, 224>({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // full frame, rotated or mirrored, 1:1 and integral scale //
+
+    // synthetic test images (small size, tracked by git)
+    failed_batched_tests_count = oriented_decoding_test<mdjpeg::Orientation::NORMAL>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::MIRROR_HORIZONTAL>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::ROTATE_180>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::MIRROR_VERTICAL>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::TRANSPOSE>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::ROTATE_90>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::TRANSVERSE>({160, 120}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::ROTATE_270>({160, 120}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, dimensions not multiples of 8 (small size, tracked by git)
+    failed_batched_tests_count = oriented_decoding_test<mdjpeg::Orientation::NORMAL>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::MIRROR_HORIZONTAL>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::ROTATE_180>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::MIRROR_VERTICAL>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::TRANSPOSE>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::ROTATE_90>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::TRANSVERSE>({150, 100}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::ROTATE_270>({150, 100}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test images, odd dimensions (small size, tracked by git)
+    failed_batched_tests_count = oriented_decoding_test<mdjpeg::Orientation::ROTATE_90, 2>({151, 101}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::TRANSVERSE, 4>({151, 101}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
+    // synthetic test image (medium size, tracked by git)
+    failed_batched_tests_count = oriented_decoding_test<mdjpeg::Orientation::ROTATE_90, 2>({800, 800}, test_imgs_dir);
+    failed_batched_tests_count += oriented_decoding_test<mdjpeg::Orientation::TRANSVERSE, 4>({800, 800}, test_imgs_dir);
+    std::cout << "Failed tests count in this batch: " << failed_batched_tests_count << "\n\n";
+    total_failed_tests_count += failed_batched_tests_count;
+
     // end decompression tests //
     /////////////////////////////
 
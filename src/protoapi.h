@@ -1,3 +1,14 @@
 #include "JpegDecoder.h"
 #include "DownscalingBlockWriter.h"
+#include "TensorBlockWriter.h"
+#include "IntegralDownscalingBlockWriter.h"
+#include "TilingBlockWriter.h"
+#include "OrientingBlockWriter.h"
+#include "FilteringBlockWriter.h"
+#include "RgbBlockWriter.h"
+#include "YuvBlockWriter.h"
+#include "StatisticsBlockWriter.h"
+#include "ThresholdingBlockWriter.h"
+#include "IntegralImageBlockWriter.h"
+#include "CompositeBlockWriter.h"
 #include "tests/test-utils.h"
@@ -1,6 +1,7 @@
 #include "states.h"
 
 #include <sys/types.h>
+#include <algorithm>
 
 #ifdef PRINT_STATES_FLOW
     #include <iostream>
@@ -21,6 +22,110 @@
 
 using namespace mdjpeg;
 
+namespace {
+
+// reads an unsigned integer of `length` bytes (up to 4) from TIFF data in its byte order
+uint32_t read_tiff_uint(const uint8_t* const data, const bool is_little_endian, const uint8_t length) noexcept {
+
+    uint32_t value = 0;
+
+    for (uint i = 0; i < length; ++i) {
+
+        value = value << 8 | data[is_little_endian ? length - 1 - i : i];
+    }
+
+    return value;
+}
+
+// locates the JPEG thumbnail in EXIF metadata of an APP1 segment (size field excluded), empty range if none
+JpegDecoder::ByteRange find_exif_thumbnail(const uint8_t* const segment, const size_t size) noexcept {
+
+    static constexpr uint8_t EXIF_ID[6] = {'E', 'x', 'i', 'f', 0, 0};
+
+    // EXIF identifier followed by TIFF header (byte order, 42, offset of IFD0)
+    if (size < sizeof(EXIF_ID) + 8 || !std::equal(EXIF_ID, EXIF_ID + sizeof(EXIF_ID), segment)) {
+
+        return {};
+    }
+
+    // all offsets are relative to the start of TIFF header
+    const uint8_t* const tiff = segment + sizeof(EXIF_ID);
+    const uint32_t tiff_size = size - sizeof(EXIF_ID);
+
+    const bool is_little_endian = tiff[0] == 'I' && tiff[1] == 'I';
+
+    if ((!is_little_endian && (tiff[0] != 'M' || tiff[1] != 'M'))
+                           || read_tiff_uint(tiff + 2, is_little_endian, 2) != 42) {
+
+        return {};
+    }
+
+    // IFD0 is only read through to get to IFD1 (entries count, 12-byte entries, offset of the next IFD)
+    const uint32_t ifd0 = read_tiff_uint(tiff + 4, is_little_endian, 4);
+
+    if (ifd0 > tiff_size - 2) {
+
+        return {};
+    }
+
+    const uint32_t ifd0_end = ifd0 + 2 + 12 * read_tiff_uint(tiff + ifd0, is_little_endian, 2);
+
+    if (ifd0_end > tiff_size - 4) {
+
+        return {};
+    }
+
+    const uint32_t ifd1 = read_tiff_uint(tiff + ifd0_end, is_little_endian, 4);
+
+    if (!ifd1 || ifd1 > tiff_size - 2) {
+
+        return {};
+    }
+
+    const uint16_t entries_count = read_tiff_uint(tiff + ifd1, is_little_endian, 2);
+
+    if (ifd1 + 2 + 12 * entries_count > tiff_size) {
+
+        return {};
+    }
+
+    uint32_t thumbnail_offset = 0;
+    uint32_t thumbnail_size = 0;
+
+    for (uint i = 0; i < entries_count; ++i) {
+
+        // tag, type, count and value (left-aligned if shorter than 4 bytes)
+        const uint8_t* const entry = tiff + ifd1 + 2 + 12 * i;
+        const uint16_t tag = read_tiff_uint(entry, is_little_endian, 2);
+        const uint8_t value_length = read_tiff_uint(entry + 2, is_little_endian, 2) == 3 ? 2 : 4;  // SHORT or LONG
+
+        // JPEGInterchangeFormat
+        if (tag == 0x0201) {
+
+            thumbnail_offset = read_tiff_uint(entry + 8, is_little_endian, value_length);
+        }
+
+        // JPEGInterchangeFormatLength
+        else if (tag == 0x0202) {
+
+            thumbnail_size = read_tiff_uint(entry + 8, is_little_endian, value_length);
+        }
+    }
+
+    // the thumbnail must lie within the segment and start with SOI marker
+    if (thumbnail_size < 2 || thumbnail_offset > tiff_size
+                           || thumbnail_size > tiff_size - thumbnail_offset
+                           || tiff[thumbnail_offset] != 0xff
+                           || tiff[thumbnail_offset + 1] != 0xd8) {
+
+        return {};
+    }
+
+    return {tiff + thumbnail_offset, thumbnail_size};
+}
+
+}  // namespace
+
 template<>
 void ConcreteState<StateID::ENTRY>::parse_header(JpegReader& reader) noexcept {
 
@@ -62,7 +167,16 @@ void ConcreteState<StateID::SOI>::parse_header(JpegReader& reader) noexcept {
 
     const auto next_marker = reader.read_marker();
 
-    if (static_cast<StateID>(*next_marker) >= StateID::APP0 && static_cast<StateID>(*next_marker) <= StateID::APP15) {
+    if (static_cast<StateID>(*next_marker) == StateID::APP1) {
+
+        #ifdef PRINT_STATES_FLOW
+            std::cout << "\nFound marker: APP1 (0x" << std::hex << *next_marker << ")\n";
+        #endif
+
+        m_decoder->set_state<StateID::APP1>();
+    }
+
+    else if (static_cast<StateID>(*next_marker) >= StateID::APP0 && static_cast<StateID>(*next_marker) <= StateID::APP15) {
 
         #ifdef PRINT_STATES_FLOW
             std::cout << "\nFound marker: APPN (0x" << std::hex << *next_marker << ")\n";
@@ -107,6 +221,15 @@ void ConcreteState<StateID::APP0>::parse_header(JpegReader& reader) noexcept {
 
     switch (static_cast<StateID>(*next_marker)) {
 
+        case StateID::APP1:
+
+            #ifdef PRINT_STATES_FLOW
+                std::cout << "\nFound marker: APP1 (0x" << std::hex << *next_marker << ")\n";
+            #endif
+
+            m_decoder->set_state<StateID::APP1>();
+            break;
+
         case StateID::DQT:
 
             #ifdef PRINT_STATES_FLOW
@@ -134,8 +257,28 @@ void ConcreteState<StateID::APP0>::parse_header(JpegReader& reader) noexcept {
             m_decoder->set_state<StateID::SOF0>();
             break;
 
+        case StateID::SOF2:
+
+            #ifdef PRINT_STATES_FLOW
+                std::cout << "\nFound marker: SOF2 (0x" << std::hex << *next_marker << ")\n";
+            #endif
+
+            m_decoder->set_state<StateID::SOF2>();
+            break;
+
         default:
 
+            // any other APPn segment
+            if (static_cast<StateID>(*next_marker) >= StateID::APP0 && static_cast<StateID>(*next_marker) <= StateID::APP15) {
+
+                #ifdef PRINT_STATES_FLOW
+                    std::cout << "\nFound marker: APPN (0x" << std::hex << *next_marker << ")\n";
+                #endif
+
+                m_decoder->set_state<StateID::APP0>();
+                break;
+            }
+
             #ifdef PRINT_STATES_FLOW
                 std::cout << "\nUnexpected or unrecognized marker: 0x" << std::hex << *next_marker << "\n";
             #endif
@@ -144,6 +287,40 @@ void ConcreteState<StateID::APP0>::parse_header(JpegReader& reader) noexcept {
     }
 }
 
+template<>
+void ConcreteState<StateID::APP1>::parse_header(JpegReader& reader) noexcept {
+
+    #ifdef PRINT_STATES_FLOW
+        std::cout << "Entered state APP1\n";
+    #endif
+
+    const uint8_t* const segment = reader.tell_ptr();
+    const auto size_msb = reader.peek(0);
+    const auto size_lsb = reader.peek(1);
+
+    if (!size_msb || !size_lsb) {
+
+        m_decoder->set_state<StateID::ERROR_PEOB>();
+        return;
+    }
+
+    const uint16_t segment_size = *size_msb << 8 | *size_lsb;
+
+    // segment is only peeked at, APP0 state skips through it (and fails on premature end of buffer)
+    if (segment_size >= 2 && segment_size <= reader.size_remaining()) {
+
+        const JpegDecoder::ByteRange thumbnail = find_exif_thumbnail(segment + 2, segment_size - 2);
+
+        // other APP1 segments (e.g. XMP) following the EXIF one must not reset a thumbnail found
+        if (thumbnail.size) {
+
+            m_decoder->m_thumbnail = thumbnail;
+        }
+    }
+
+    m_decoder->set_state<StateID::APP0>();
+}
+
 template<>
 void ConcreteState<StateID::DQT>::parse_header(JpegReader& reader) noexcept {
 
@@ -212,6 +389,15 @@ void ConcreteState<StateID::DQT>::parse_header(JpegReader& reader) noexcept {
             m_decoder->set_state<StateID::SOF0>();
             break;
 
+        case StateID::SOF2:
+
+            #ifdef PRINT_STATES_FLOW
+                std::cout << "\nFound marker: SOF2 (0x" << std::hex << *next_marker << ")\n";
+            #endif
+
+            m_decoder->set_state<StateID::SOF2>();
+            break;
+
         case StateID::SOS:
 
             #ifdef PRINT_STATES_FLOW
@@ -299,6 +485,15 @@ void ConcreteState<StateID::DHT>::parse_header(JpegReader& reader) noexcept {
             m_decoder->set_state<StateID::SOF0>();
             break;
 
+        case StateID::SOF2:
+
+            #ifdef PRINT_STATES_FLOW
+                std::cout << "\nFound marker: SOF2 (0x" << std::hex << *next_marker << ")\n";
+            #endif
+
+            m_decoder->set_state<StateID::SOF2>();
+            break;
+
         case StateID::SOS:
 
             #ifdef PRINT_STATES_FLOW
@@ -333,8 +528,8 @@ void ConcreteState<StateID::SOF0>::parse_header(JpegReader& reader) noexcept {
         return;
     }
 
-    // only the 3-component Y'CrCb color space is supported
-    if (segment_size != 15) {
+    // only the 3-component Y'CbCr and the 1-component grayscale color spaces are supported
+    if (segment_size != 15 && segment_size != 9) {
 
         m_decoder->set_state<StateID::ERROR_UPAR>();
         return;
@@ -343,23 +538,25 @@ void ConcreteState<StateID::SOF0>::parse_header(JpegReader& reader) noexcept {
     const uint8_t precision = *reader.read_uint8();
     const uint16_t height_px = *reader.read_uint16();
     const uint16_t width_px = *reader.read_uint16();
-    uint8_t components_count = *reader.read_uint8();
+    const uint8_t frame_components_count = *reader.read_uint8();
 
     if (precision != 8 || !height_px
                        || !width_px
-                       || components_count != 3) {
+                       || segment_size != 6 + 3 * frame_components_count) {
 
         m_decoder->set_state<StateID::ERROR_UPAR>();
         return;
     }
 
+    uint8_t components_count = frame_components_count;
+
     while ((components_count)--) {
 
         const uint8_t component_id = *reader.read_uint8();
         const uint8_t sampling_factor = *reader.read_uint8();
         const uint8_t qtable_id = *reader.read_uint8();
 
-        // supported component IDs: 1, 2 and 3 (Y', Cr and Cb channel, respectively)
+        // supported component IDs: 1, 2 and 3 (Y', Cb and Cr channel, respectively)
         if (component_id == 0 || component_id > 3 ) {
 
             m_decoder->set_state<StateID::ERROR_UPAR>();
@@ -375,22 +572,41 @@ void ConcreteState<StateID::SOF0>::parse_header(JpegReader& reader) noexcept {
                 return;
             }
 
-            // component 1 must use sampling factors 0x11 or 0x21
-            if (sampling_factor != 0x11 && sampling_factor != 0x21 ) {
+            // sampling factors of the only component have no effect (its scan is non-interleaved, one block per MCU)
+            if (frame_components_count == 1) {
+
+                m_decoder->m_frame_info.set(height_px, width_px, 1, 1, frame_components_count);
+                continue;
+            }
+
+            // component 1 must use sampling factors 0x11, 0x21 or 0x22
+            if (sampling_factor != 0x11 && sampling_factor != 0x21 && sampling_factor != 0x22) {
 
                 m_decoder->set_state<StateID::ERROR_UPAR>();
                 return;
             }
 
-            m_decoder->m_frame_info.set(height_px, width_px, sampling_factor >> 4);
+            m_decoder->m_frame_info.set(height_px, width_px, sampling_factor >> 4, sampling_factor & 0xf, frame_components_count);
         }
 
-        // components 2 and 3 must use sampling factors 0x11
-        if (component_id > 1 && sampling_factor != 0x11) {
+        // grayscale frames consist of component 1 only
+        if (component_id > 1 && frame_components_count == 1) {
 
             m_decoder->set_state<StateID::ERROR_UPAR>();
             return;
         }
+
+        if (component_id > 1) {
+
+            // components 2 and 3 must use sampling factors 0x11 and a valid qtable ID
+            if (sampling_factor != 0x11 || qtable_id > 3) {
+
+                m_decoder->set_state<StateID::ERROR_UPAR>();
+                return;
+            }
+
+            m_decoder->m_frame_info.chroma_qtable_ids[component_id - 2] = qtable_id;
+        }
     }
 
     const auto next_marker = reader.read_marker();
@@ -440,6 +656,18 @@ void ConcreteState<StateID::SOF0>::parse_header(JpegReader& reader) noexcept {
     }
 }
 
+template<>
+void ConcreteState<StateID::SOF2>::parse_header([[maybe_unused]] JpegReader& reader) noexcept {
+
+    #ifdef PRINT_STATES_FLOW
+        std::cout << "Entered state SOF2\n";
+    #endif
+
+    // frame header segment is the same as for baseline JPEG
+    m_decoder->m_frame_info.is_progressive = true;
+    m_decoder->set_state<StateID::SOF0>();
+}
+
 template<>
 void ConcreteState<StateID::SOS>::parse_header(JpegReader& reader) noexcept {
 
@@ -447,14 +675,19 @@ void ConcreteState<StateID::SOS>::parse_header(JpegReader& reader) noexcept {
         std::cout << "Entered state SOS\n";
     #endif
 
-    // at this point, DQT, DHT and SOF0 segments must have been parsed
-    if (!m_decoder->m_dequantizer.is_set() || !m_decoder->m_huffman.is_set()
-                                           || !m_decoder->m_frame_info.is_set()) {
+    const uint8_t frame_components_count = m_decoder->m_frame_info.components_count;
+    const bool is_progressive = m_decoder->m_frame_info.is_progressive;
+
+    // at this point, DQT and SOF0 segments must have been parsed
+    if (!m_decoder->m_frame_info.is_set() || !m_decoder->m_dequantizer.is_set()) {
 
         m_decoder->set_state<StateID::ERROR_UUM>();
         return;
     }
 
+    // htables not set by DHT segments (if any) default to the typical ones, MJPEG frames commonly omit DHT segments
+    m_decoder->m_huffman.set_default_htables();
+
     const uint16_t segment_size = reader.read_segment_size();
 
     if (segment_size > reader.size_remaining()) {
@@ -463,30 +696,27 @@ void ConcreteState<StateID::SOS>::parse_header(JpegReader& reader) noexcept {
         return;
     }
 
-    // only the 3-component Y'CrCb color space is supported
-    if (segment_size != 10) {
-
-        m_decoder->set_state<StateID::ERROR_UPAR>();
-        return;
-    }
-
     auto components_count = reader.read_uint8();
 
-    if (*components_count != 3) {
+    // the scan must include all components of the frame, the first DC scan of a progressive frame may include luma only
+    if (!components_count || (*components_count != frame_components_count && (!is_progressive || *components_count != 1))
+                          || segment_size != 4 + 2 * *components_count) {
 
         m_decoder->set_state<StateID::ERROR_UPAR>();
         return;
     }
 
-    while ((*components_count)--) {
+    const uint8_t scan_components_count = *components_count;
+
+    for (uint8_t i = 0; i < scan_components_count; ++i) {
 
         const auto component_id = reader.read_uint8();
         const auto dc_ac_table_ids = reader.read_uint8();
 
-        // component 1 must use both (DC and AC) htable IDs 0
-        if (component_id && *component_id == 1
-                         && dc_ac_table_ids
-                         && *dc_ac_table_ids != 0 ) {
+        // component 1 must use both (DC and AC) htable IDs 0, luma-only scans must include component 1
+        if (!component_id || !dc_ac_table_ids
+                          || (scan_components_count == 1 && *component_id != 1)
+                          || (*component_id == 1 && *dc_ac_table_ids != 0)) {
 
             m_decoder->set_state<StateID::ERROR_UPAR>();
             return;
@@ -497,12 +727,36 @@ void ConcreteState<StateID::SOS>::parse_header(JpegReader& reader) noexcept {
     const uint8_t end_of_selection = *reader.read_uint8();
     const uint8_t successive_approximation = *reader.read_uint8();
 
-    // only baseline JPEG is supported
-    if (start_of_selection != 0 || end_of_selection != 63
-                                || successive_approximation != 0) {
+    if (!is_progressive) {
+
+        // only baseline JPEG is supported
+        if (start_of_selection != 0 || end_of_selection != 63
+                                    || successive_approximation != 0) {
+
+            m_decoder->set_state<StateID::ERROR_UPAR>();
+            return;
+        }
+    }
+
+    else {
+
+        // only the first DC scan of a progressive frame is supported (point transform in the low nibble)
+        if (start_of_selection != 0 || end_of_selection != 0
+                                    || successive_approximation > 0x0d) {
 
             m_decoder->set_state<StateID::ERROR_UPAR>();
             return;
+        }
+
+        // luma-only scan is non-interleaved (one block per MCU), same as the scan of a grayscale frame
+        if (scan_components_count == 1) {
+
+            JpegDecoder::FrameInfo& frame_info = m_decoder->m_frame_info;
+
+            frame_info.set(frame_info.height_px, frame_info.width_px, 1, 1, 1);
+        }
+
+        m_decoder->m_huffman.set_dc_scan(successive_approximation & 0x0f);
     }
 
     reader.mark_start_of_ecs();
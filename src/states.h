@@ -145,7 +145,7 @@ class State {
 ///
 /// \note Doxygen (1.9.1 as well as 1.9.8) still cannot correctly handle
 /// documentation for member function specializations of a class template.
-/// This class contains \ref temp_specs "seven of them in a group" but not all
+/// This class contains \ref temp_specs "nine of them in a group" but not all
 /// of their documentation gets generated by Doxygen, some of it is duplicated
 /// and all of it lacks any readability. For better overview check the raw
 /// comments in the source code of states.h.
@@ -185,34 +185,49 @@ void ConcreteState<StateID::ENTRY>::parse_header(JpegReader& reader) noexcept;
 /// \addtogroup temp_specs
 /// \brief Step function specialization for the state defined by StateID::SOI.
 ///
-/// Validates the next expected marker: \e APP0. Sets the next state of the
-/// state machine to the one defined by StateID::APP0 or one of the invalid
+/// Validates the next expected marker: any \e APPn. Sets the next state of the
+/// state machine to the one defined by StateID::APP1 for \e APP1, to the one
+/// defined by StateID::APP0 for all other \e APPn or to one of the invalid
 /// final states, depending on the validation outcome.
-///
-/// \note Other APP markers are not supported.
 template<>
 void ConcreteState<StateID::SOI>::parse_header(JpegReader& reader) noexcept;
 
 /// \addtogroup temp_specs
 /// \brief Step function specialization for the state defined by StateID::APP0.
 ///
-/// Skips through \e APP0 segment. Validates the next expected marker: \e DQT,
-/// \e DHT or \e SOF0. Sets the next state of the state machine to the one
-/// defined by StateID::DQT, StateID::DHT, StateID::SOF0 or one of the invalid
-/// final states, depending on the validation outcome.
+/// Skips through \e APPn segment (any of them). Validates the next expected
+/// marker: \e APPn, \e DQT, \e DHT, \e SOF0 or \e SOF2. Sets the next state of
+/// the state machine to the one defined by StateID::APP1 (for \e APP1),
+/// StateID::APP0 (for all other \e APPn), StateID::DQT, StateID::DHT,
+/// StateID::SOF0, StateID::SOF2 or one of the invalid final states, depending
+/// on the validation outcome.
 ///
 /// \note Other SOF markers are not supported.
 template<>
 void ConcreteState<StateID::APP0>::parse_header(JpegReader& reader) noexcept;
 
+/// \addtogroup temp_specs
+/// \brief Step function specialization for the state defined by StateID::APP1.
+///
+/// Looks for the JPEG thumbnail in EXIF metadata of \e APP1 segment and stores
+/// its location (see JpegDecoder::get_thumbnail). Sets the next state of the
+/// state machine to the one defined by StateID::APP0 without advancing past
+/// the segment, which is then skipped through as any other \e APPn segment.
+///
+/// \note \e APP1 segments other than EXIF, EXIF metadata without IFD1 and
+/// thumbnails other than JPEG ones are skipped through silently, leaving a
+/// thumbnail found in a preceding \e APP1 segment in place.
+template<>
+void ConcreteState<StateID::APP1>::parse_header(JpegReader& reader) noexcept;
+
 /// \addtogroup temp_specs
 /// \brief Step function specialization for the state defined by StateID::DQT.
 ///
 /// Sets luma quantization table, skips over chroma quantization table.
-/// Validates the next expected marker: \e DQT, \e DHT, \e SOF0 or \e SOS. Sets
-/// the next state of the state machine to the one defined by StateID::DQT,
-/// StateID::DHT, StateID::SOF0, StateID::SOS or one of the invalid final
-/// states, depending on the validation outcome.
+/// Validates the next expected marker: \e DQT, \e DHT, \e SOF0, \e SOF2 or
+/// \e SOS. Sets the next state of the state machine to the one defined by
+/// StateID::DQT, StateID::DHT, StateID::SOF0, StateID::SOF2, StateID::SOS or
+/// one of the invalid final states, depending on the validation outcome.
 ///
 /// \note Other SOF markers are not supported.
 template<>
@@ -222,9 +237,10 @@ void ConcreteState<StateID::DQT>::parse_header(JpegReader& reader) noexcept;
 /// \brief Step function specialization for the state defined by StateID::DHT.
 ///
 /// Sets %Huffman tables. Validates the next expected marker: \e DQT, \e DHT,
-/// \e SOF0 or \e SOS. Sets the next state of the state machine to the one
-/// defined by StateID::DQT, StateID::DHT, StateID::SOF0, StateID::SOS or one of
-/// the invalid final states, depending on the validation outcome.
+/// \e SOF0, \e SOF2 or \e SOS. Sets the next state of the state machine to the
+/// one defined by StateID::DQT, StateID::DHT, StateID::SOF0, StateID::SOF2,
+/// StateID::SOS or one of the invalid final states, depending on the validation
+/// outcome.
 ///
 /// \note Other SOF markers are not supported.
 template<>
@@ -240,21 +256,38 @@ void ConcreteState<StateID::DHT>::parse_header(JpegReader& reader) noexcept;
 /// one of the invalid final states, depending on validations outcome.
 ///
 /// \note Quantization table precision other than 8 bits is not supported. Color
-/// spaces other than Y'CbCr are not supported. Chroma subsampling schemes other
-/// than 4:4:4 and 4:2:2 are not supported.
+/// spaces other than Y'CbCr and grayscale (single component) are not supported.
+/// Chroma subsampling schemes other than 4:4:4, 4:2:2 and 4:2:0 are not
+/// supported.
 template<>
 void ConcreteState<StateID::SOF0>::parse_header(JpegReader& reader) noexcept;
 
+/// \addtogroup temp_specs
+/// \brief Step function specialization for the state defined by StateID::SOF2.
+///
+/// Marks the frame as progressive. Sets the next state of the state machine to
+/// the one defined by StateID::SOF0 without reading anything, since \e SOF2
+/// segment has the same layout as \e SOF0 segment.
+template<>
+void ConcreteState<StateID::SOF2>::parse_header(JpegReader& reader) noexcept;
+
 /// \addtogroup temp_specs
 /// \brief Step function specialization for the state defined by StateID::SOS.
 ///
 /// Validates that all prerequisite metadata has been found and set. Validates
-/// that \e SOS segment describes the supported baseline JPEG mode. Marks the
-/// start of entropy coded segment. Sets the next state of the state machine to
-/// the one defined by StateID::HEADER_OK or one of the invalid final states,
-/// depending on validations outcome.
+/// that \e SOS segment describes one of the supported scans: the only scan of
+/// a baseline frame, or the first DC scan of a progressive frame (interleaved
+/// or luma only). Marks the start of entropy coded segment. Sets the next state
+/// of the state machine to the one defined by StateID::HEADER_OK or one of the
+/// invalid final states, depending on validations outcome.
+///
+/// %Huffman tables not defined by any preceding \e DHT segment default to the
+/// typical tables (see Huffman::set_default_htables), so that MJPEG frames
+/// omitting \e DHT segments are supported.
 ///
-/// \note Modes other than baseline JPEG are not supported.
+/// \note Scans of progressive frames other than the first one (further DC
+/// refinements and all AC scans) are never reached. Luma-only DC scans of
+/// Y'CbCr frames are decoded as grayscale frames.
 template<>
 void ConcreteState<StateID::SOS>::parse_header(JpegReader& reader) noexcept;
 
@@ -108,6 +108,36 @@ bool mdjpeg::test_utils::write_as_pgm(const std::filesystem::path& file_path, co
     return true;
 }
 
+bool mdjpeg::test_utils::write_as_ppm(const std::filesystem::path& file_path, const uint8_t* const pixel_data, const uint16_t width_px, const uint16_t height_px) {
+
+    std::ofstream file(file_path);
+
+    if (!file.is_open()) {
+
+        std::cout << "Error opening output file: " << file_path.c_str() << "\n";
+
+        return false;
+    }
+
+    file << "P3\n" << width_px << " " << height_px << " " << 255 << "\n";
+
+    uint idx = 0;
+    for (uint row = 0; row < height_px; ++row) {
+
+        for (uint col = 0; col < 3 * width_px; ++col) {
+
+            file << static_cast<uint>(pixel_data[idx++]) << " ";
+        }
+
+        file << "\n";
+    }
+
+    file << "\n";
+    file.close();
+
+    return true;
+}
+
 void mdjpeg::test_utils::print_as_pgm(const uint8_t* const pixel_data, const uint16_t width_px, const uint16_t height_px) {
 
     std::cout << "P2\n" << width_px << " " << height_px << " " << 255 << "\n";
@@ -13,8 +13,8 @@ struct Dimensions {
     Dimensions(uint16_t width_px, uint16_t height_px) :
         width_px(width_px),
         height_px(height_px),
-        width_blk(width_px / 8),
-        height_blk(height_px / 8)
+        width_blk((width_px + 7) / 8),
+        height_blk((height_px + 7) / 8)
         {}
 
     uint16_t width_px {};
@@ -39,6 +39,8 @@ uint max_abs_error(const uint8_t* array, const Dimensions& dims, uint8_t value);
 
 bool write_as_pgm(const std::filesystem::path& file_path, const uint8_t* pixel_data, uint16_t width_px, uint16_t height_px);
 
+bool write_as_ppm(const std::filesystem::path& file_path, const uint8_t* pixel_data, uint16_t width_px, uint16_t height_px);
+
 void print_as_pgm(const uint8_t* pixel_data, uint16_t width_px, uint16_t height_px);
 
 }  // namespace mdjpeg::test_utils
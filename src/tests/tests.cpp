@@ -1,5 +1,6 @@
 #include "tests.h"
 
+#include <algorithm>
 #include <fstream>
 
 
@@ -7,8 +8,6 @@ uint full_frame_dc_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims
                                   const std::filesystem::path& test_imgs_dir,
                                   const std::filesystem::path& output_subdir) {
 
-    assert(src_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 8)");
-
     using namespace mdjpeg::test_utils;
 
     const auto input_files_dir = test_imgs_dir / src_dims.to_str();
@@ -55,12 +54,65 @@ uint full_frame_dc_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims
     return tests_failed;
 }
 
+uint full_frame_dc_color_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                                        const std::filesystem::path& test_imgs_dir,
+                                        const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    const uint32_t area_blk = src_dims.width_blk * src_dims.height_blk;
+    const mdjpeg::BoundingBox roi_blk {0, 0, src_dims.width_blk, src_dims.height_blk};
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Full-frame DC-only color decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_rgb888 = std::make_unique<uint8_t[]>(3 * area_blk);
+        std::unique_ptr<uint8_t[]> decoded_ycbcr = std::make_unique<uint8_t[]>(3 * area_blk);
+
+        if (decoder.dc_color_decode(decoded_rgb888.get(), roi_blk) && decoder.dc_color_decode(decoded_ycbcr.get(), roi_blk, true)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::string stem = file_path.stem();
+
+            if (!write_as_ppm(output_dir / (stem + "_rgb888.ppm"), decoded_rgb888.get(), src_dims.width_blk, src_dims.height_blk)
+                || !write_as_ppm(output_dir / (stem + "_ycbcr.ppm"), decoded_ycbcr.get(), src_dims.width_blk, src_dims.height_blk)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
 uint full_frame_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
                                const std::filesystem::path& test_imgs_dir,
                                const std::filesystem::path& output_subdir) {
 
-    assert(src_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 8)");
-
     using namespace mdjpeg::test_utils;
 
     const auto input_files_dir = test_imgs_dir / src_dims.to_str();
@@ -107,6 +159,130 @@ uint full_frame_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
     return tests_failed;
 }
 
+uint full_frame_band_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                                    const std::filesystem::path& test_imgs_dir,
+                                    const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Full-frame band decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        mdjpeg::BasicBlockWriter writer;
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(src_dims.width_px * src_dims.height_px);
+        std::unique_ptr<uint8_t[]> band_buff = std::make_unique<uint8_t[]>(64 * src_dims.width_blk);
+
+        if (decoder.luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk}, writer, band_buff.get())) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = file_path.filename().replace_extension("pgm");
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), src_dims.width_px, src_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint reused_tables_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                                  const std::filesystem::path& test_imgs_dir,
+                                  const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    // overwrites payloads of all DQT and DHT segments preceding the SOS segment
+    const auto overwrite_tables = [](uint8_t* const buff, const size_t size) {
+
+        size_t idx = 2;
+
+        while (idx + 4 <= size && buff[idx] == 0xff && buff[idx + 1] != 0xda) {
+
+            const size_t segment_end = idx + 2 + (buff[idx + 2] << 8 | buff[idx + 3]);
+
+            if (buff[idx + 1] == 0xdb || buff[idx + 1] == 0xc4) {
+
+                std::fill(buff + idx + 4, buff + std::min(segment_end, size), 0);
+            }
+
+            idx = segment_end;
+        }
+    };
+
+    mdjpeg::JpegDecoder decoder;
+    uint tests_failed = 0;
+
+    for (uint pass = 1; pass <= 2; ++pass) {
+
+        for (const auto& file_path : input_files_paths) {
+
+            std::cout << "Reused-tables decoding test (pass " << pass << ") on \"" << file_path.filename().c_str() << "\"";
+
+            const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+            const bool is_assigned = decoder.assign(buff, size);
+            overwrite_tables(buff, size);
+            std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(src_dims.width_px * src_dims.height_px);
+
+            if (is_assigned && decoder.luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk})) {
+
+                std::filesystem::create_directory(output_dir);
+                const std::filesystem::path filename = file_path.filename().replace_extension("pgm");
+
+                if (!write_as_pgm(output_dir / filename, decoded_img.get(), src_dims.width_px, src_dims.height_px)) {
+
+                    ++tests_failed;
+                    std::cout << ": FAILED writing output\n";
+                }
+
+                else {
+
+                    std::cout << ": PASSED (tentative)\n";
+                }
+            }
+
+            else {
+
+                ++tests_failed;
+                std::cout << ": FAILED decoding JPEG\n";
+            }
+
+            delete[] buff;
+        }
+    }
+
+    return tests_failed;
+}
+
 uint cropped_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
                             const std::filesystem::path& test_imgs_dir,
                             const std::filesystem::path& output_subdir) {
@@ -187,3 +363,854 @@ uint cropped_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
 
     return tests_failed;
 }
+
+uint pixel_cropped_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                                  const std::filesystem::path& test_imgs_dir,
+                                  const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    constexpr uint16_t THUMB_WIDTH_PX = 64;
+    constexpr uint16_t THUMB_HEIGHT_PX = 48;
+
+    // region of interest with borders off the block grid, reaching into the last row of blocks
+    const mdjpeg::BoundingBox roi_px {static_cast<uint16_t>(src_dims.width_px / 16 + 3),
+                                      static_cast<uint16_t>(src_dims.height_px / 16 + 5),
+                                      static_cast<uint16_t>(src_dims.width_px - src_dims.width_px / 8 - 1),
+                                      static_cast<uint16_t>(src_dims.height_px - 3)};
+
+    const Dimensions dst_dims {roi_px.width(), roi_px.height()};
+    const Dimensions thumb_dims {THUMB_WIDTH_PX, THUMB_HEIGHT_PX};
+
+    assert(dst_dims.width_px >= THUMB_WIDTH_PX && dst_dims.height_px >= THUMB_HEIGHT_PX && "invalid input dimensions (too small)");
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Pixel-accurate cropped decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(dst_dims.width_px * dst_dims.height_px);
+        std::unique_ptr<uint8_t[]> decoded_thumb = std::make_unique<uint8_t[]>(THUMB_WIDTH_PX * THUMB_HEIGHT_PX);
+
+        mdjpeg::BasicBlockWriter full_scale_writer;
+        mdjpeg::DownscalingBlockWriter<THUMB_WIDTH_PX, THUMB_HEIGHT_PX> downscaling_writer;
+        mdjpeg::CompositeBlockWriter<2> writer;
+        writer.attach(full_scale_writer, decoded_img.get());
+        writer.attach(downscaling_writer, decoded_thumb.get());
+
+        // writers that do not support cropping would write output for the enclosing blocks
+        mdjpeg::ThresholdingBlockWriter non_cropping_writer;
+
+        if (decoder.luma_decode_px(decoded_img.get(), roi_px, non_cropping_writer)) {
+
+            ++tests_failed;
+            std::cout << ": FAILED rejecting writer without cropping support\n";
+        }
+
+        else if (decoder.luma_decode_px(nullptr, roi_px, writer)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = std::string(file_path.stem()) + "_" + dst_dims.to_str() + ".pgm";
+            const std::filesystem::path thumb_filename = std::string(file_path.stem()) + "_" + dst_dims.to_str() + "_to_" + thumb_dims.to_str() + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), dst_dims.width_px, dst_dims.height_px)
+                || !write_as_pgm(output_dir / thumb_filename, decoded_thumb.get(), THUMB_WIDTH_PX, THUMB_HEIGHT_PX)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint strided_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                            const std::filesystem::path& test_imgs_dir,
+                            const uint8_t stride,
+                            const std::filesystem::path& output_subdir) {
+
+    assert(src_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 8)");
+
+    using namespace mdjpeg::test_utils;
+
+    const Dimensions dst_dims {static_cast<uint16_t>(8 * ((src_dims.width_blk + stride - 1) / stride)),
+                               static_cast<uint16_t>(8 * ((src_dims.height_blk + stride - 1) / stride))};
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Strided (1 in " << +stride << ") decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(dst_dims.width_px * dst_dims.height_px);
+
+        if (decoder.strided_luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk}, stride)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = std::string(file_path.stem()) + "_1-in-" + std::to_string(stride) + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), dst_dims.width_px, dst_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint foveated_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                             const std::filesystem::path& test_imgs_dir,
+                             const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    constexpr uint8_t ROIS_COUNT = 3;
+
+    const Dimensions tile_dims {static_cast<uint16_t>(src_dims.width_px / 4),
+                                static_cast<uint16_t>(src_dims.height_px / 4)};
+
+    // see cropped_decoding_tests
+    assert(tile_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 32)");
+
+    const uint16_t w = tile_dims.width_blk;
+    const uint16_t h = tile_dims.height_blk;
+
+    const mdjpeg::BoundingBox rois_blk[ROIS_COUNT] = {{w, h, static_cast<uint16_t>(2 * w), static_cast<uint16_t>(2 * h)},
+                                                      {static_cast<uint16_t>(2 * w), static_cast<uint16_t>(2 * h),
+                                                       static_cast<uint16_t>(3 * w), static_cast<uint16_t>(3 * h)},
+                                                      {w, h, static_cast<uint16_t>(3 * w), static_cast<uint16_t>(2 * h)}};
+
+    const std::string rois_names[ROIS_COUNT] = {"5", "A", "5-6"};
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Foveated decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_overview = std::make_unique<uint8_t[]>(src_dims.width_blk * src_dims.height_blk);
+        std::unique_ptr<uint8_t[]> decoded_rois[ROIS_COUNT];
+        uint8_t* dsts[ROIS_COUNT];
+        mdjpeg::BasicBlockWriter roi_writers[ROIS_COUNT];
+        mdjpeg::BlockWriter* writers[ROIS_COUNT];
+
+        for (uint i = 0; i < ROIS_COUNT; ++i) {
+
+            decoded_rois[i] = std::make_unique<uint8_t[]>(64 * rois_blk[i].width() * rois_blk[i].height());
+            dsts[i] = decoded_rois[i].get();
+            writers[i] = &roi_writers[i];
+        }
+
+        if (decoder.foveated_luma_decode(decoded_overview.get(), rois_blk, writers, dsts, ROIS_COUNT)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = file_path.filename().replace_extension("pgm");
+            bool is_written = write_as_pgm(output_dir / filename, decoded_overview.get(), src_dims.width_blk, src_dims.height_blk);
+
+            for (uint i = 0; i < ROIS_COUNT; ++i) {
+
+                const std::filesystem::path roi_filename = std::string(file_path.stem()) + "_" + rois_names[i] + ".pgm";
+
+                is_written = write_as_pgm(output_dir / roi_filename, dsts[i], 8 * rois_blk[i].width(), 8 * rois_blk[i].height()) && is_written;
+            }
+
+            if (!is_written) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint mosaic_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                           const std::filesystem::path& test_imgs_dir,
+                           const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const Dimensions tile_dims {static_cast<uint16_t>(src_dims.width_px / 4),
+                                static_cast<uint16_t>(src_dims.height_px / 4)};
+
+    // see cropped_decoding_tests
+    assert(tile_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 32)");
+
+    const Dimensions downscaled_dims {static_cast<uint16_t>(src_dims.width_px / 2),
+                                      static_cast<uint16_t>(src_dims.height_px / 2)};
+
+    const uint32_t img_size = src_dims.width_px * src_dims.height_px;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Mosaic decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        mdjpeg::BasicBlockWriter writer;
+        mdjpeg::IntegralDownscalingBlockWriter<2> downscaling_writer;
+        mdjpeg::ThresholdingBlockWriter thresholding_writer;
+        std::unique_ptr<uint8_t[]> canvas = std::make_unique<uint8_t[]>(img_size);
+        std::unique_ptr<uint8_t[]> downscaled_canvas = std::make_unique<uint8_t[]>(downscaled_dims.width_px * downscaled_dims.height_px);
+        std::unique_ptr<uint8_t[]> mask_canvas = std::make_unique<uint8_t[]>(src_dims.width_blk * src_dims.height_px);
+        std::unique_ptr<uint8_t[]> thresholded_img = std::make_unique<uint8_t[]>(img_size);
+
+        // decodes all subimages directly into their places within a canvas,
+        // destination pitch and origins expressed in the writer's own output units
+        const auto decode_mosaic = [&](mdjpeg::BlockWriter& mosaic_writer, uint8_t* const mosaic_canvas, const uint32_t pitch,
+                                       const uint8_t blk_width, const uint8_t blk_height) {
+
+            for (uint16_t row_blk = 0; row_blk < src_dims.height_blk; row_blk += tile_dims.height_blk) {
+
+                for (uint16_t col_blk = 0; col_blk < src_dims.width_blk; col_blk += tile_dims.width_blk) {
+
+                    mosaic_writer.set_dst_layout(pitch, blk_width * col_blk, blk_height * row_blk);
+
+                    if (!decoder.luma_decode(mosaic_canvas, {col_blk,
+                                                             row_blk,
+                                                             static_cast<uint16_t>(col_blk + tile_dims.width_blk),
+                                                             static_cast<uint16_t>(row_blk + tile_dims.height_blk)}, mosaic_writer)) {
+
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        };
+
+        // the thresholding writer's layout is expressed in bytes, i.e. a single one per block column
+        if (decode_mosaic(writer, canvas.get(), src_dims.width_px, 8, 8)
+            && decode_mosaic(downscaling_writer, downscaled_canvas.get(), downscaled_dims.width_px, 4, 4)
+            && decode_mosaic(thresholding_writer, mask_canvas.get(), src_dims.width_blk, 1, 8)) {
+
+            // unpack the mask to black and white pixels
+            for (uint32_t i = 0; i < img_size; ++i) {
+
+                thresholded_img[i] = (mask_canvas[i / 8] >> (7 - i % 8) & 1) ? 255 : 0;
+            }
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = file_path.filename().replace_extension("pgm");
+            const std::filesystem::path downscaled_filename = std::string(file_path.stem()) + "_downscaled.pgm";
+            const std::filesystem::path thresholded_filename = std::string(file_path.stem()) + "_thresholded.pgm";
+
+            if (!write_as_pgm(output_dir / filename, canvas.get(), src_dims.width_px, src_dims.height_px)
+                || !write_as_pgm(output_dir / downscaled_filename, downscaled_canvas.get(), downscaled_dims.width_px, downscaled_dims.height_px)
+                || !write_as_pgm(output_dir / thresholded_filename, thresholded_img.get(), src_dims.width_px, src_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint color_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                          const std::filesystem::path& test_imgs_dir,
+                          const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const Dimensions cropped_dims {static_cast<uint16_t>(8 * (src_dims.width_blk - 2)),
+                                   static_cast<uint16_t>(8 * (src_dims.height_blk - 2))};
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    const uint32_t area_px = src_dims.width_px * src_dims.height_px;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Color decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_rgb888 = std::make_unique<uint8_t[]>(3 * area_px);
+        std::unique_ptr<uint16_t[]> decoded_rgb565 = std::make_unique<uint16_t[]>(area_px);
+        std::unique_ptr<uint8_t[]> expanded_rgb565 = std::make_unique<uint8_t[]>(3 * area_px);
+        std::unique_ptr<uint8_t[]> decoded_cropped = std::make_unique<uint8_t[]>(3 * cropped_dims.width_px * cropped_dims.height_px);
+
+        mdjpeg::RgbBlockWriter<mdjpeg::PixelFormat::RGB565> rgb565_writer;
+
+        if (decoder.color_decode(decoded_rgb888.get(), {0, 0, src_dims.width_blk, src_dims.height_blk})
+            && decoder.color_decode(reinterpret_cast<uint8_t*>(decoded_rgb565.get()), {0, 0, src_dims.width_blk, src_dims.height_blk}, rgb565_writer)
+            && decoder.color_decode(decoded_cropped.get(), {1, 1, static_cast<uint16_t>(src_dims.width_blk - 1), static_cast<uint16_t>(src_dims.height_blk - 1)})) {
+
+            for (uint i = 0; i < area_px; ++i) {
+
+                const uint16_t px = decoded_rgb565[i];
+                const uint8_t r = px >> 11;
+                const uint8_t g = px >> 5 & 0x3f;
+                const uint8_t b = px & 0x1f;
+
+                expanded_rgb565[3 * i] = r << 3 | r >> 2;
+                expanded_rgb565[3 * i + 1] = g << 2 | g >> 4;
+                expanded_rgb565[3 * i + 2] = b << 3 | b >> 2;
+            }
+
+            std::filesystem::create_directory(output_dir);
+            const std::string stem = file_path.stem();
+
+            if (!write_as_ppm(output_dir / (stem + "_rgb888.ppm"), decoded_rgb888.get(), src_dims.width_px, src_dims.height_px)
+                || !write_as_ppm(output_dir / (stem + "_rgb565.ppm"), expanded_rgb565.get(), src_dims.width_px, src_dims.height_px)
+                || !write_as_ppm(output_dir / (stem + "_rgb888_" + cropped_dims.to_str() + ".ppm"), decoded_cropped.get(), cropped_dims.width_px, cropped_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint yuv_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                        const std::filesystem::path& test_imgs_dir,
+                        const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    // odd frame dimensions are extended to even ones (see YuvBlockWriter)
+    const uint16_t width_px = (src_dims.width_px + 1) & ~1u;
+    const uint16_t height_px = (src_dims.height_px + 1) & ~1u;
+
+    const uint32_t area_px = width_px * height_px;
+    const uint16_t planar_height_px = height_px * 3 / 2;
+    const uint16_t packed_width_px = width_px * 2;
+    const mdjpeg::BoundingBox roi_blk {0, 0, src_dims.width_blk, src_dims.height_blk};
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "YUV decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_i420 = std::make_unique<uint8_t[]>(area_px * 3 / 2);
+        std::unique_ptr<uint8_t[]> decoded_nv12 = std::make_unique<uint8_t[]>(area_px * 3 / 2);
+        std::unique_ptr<uint8_t[]> decoded_yuyv = std::make_unique<uint8_t[]>(area_px * 2);
+
+        mdjpeg::YuvBlockWriter<mdjpeg::YuvFormat::I420> i420_writer;
+        mdjpeg::YuvBlockWriter<mdjpeg::YuvFormat::NV12> nv12_writer;
+        mdjpeg::YuvBlockWriter<mdjpeg::YuvFormat::YUYV> yuyv_writer;
+
+        if (decoder.color_decode(decoded_i420.get(), roi_blk, i420_writer)
+            && decoder.color_decode(decoded_nv12.get(), roi_blk, nv12_writer)
+            && decoder.color_decode(decoded_yuyv.get(), roi_blk, yuyv_writer)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::string stem = file_path.stem();
+
+            if (!write_as_pgm(output_dir / (stem + "_i420.pgm"), decoded_i420.get(), width_px, planar_height_px)
+                || !write_as_pgm(output_dir / (stem + "_nv12.pgm"), decoded_nv12.get(), width_px, planar_height_px)
+                || !write_as_pgm(output_dir / (stem + "_yuyv.pgm"), decoded_yuyv.get(), packed_width_px, height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint thumbnail_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                              const std::filesystem::path& test_imgs_dir,
+                              const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Thumbnail decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+
+        if (!decoder.get_thumbnail().size) {
+
+            std::cout << ": SKIPPED (no embedded thumbnail)\n";
+        }
+
+        else if (!decoder.assign_thumbnail()) {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        else {
+
+            const Dimensions thumbnail_dims {decoder.get_width(), decoder.get_height()};
+            std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(3 * thumbnail_dims.width_px * thumbnail_dims.height_px);
+
+            if (decoder.color_decode(decoded_img.get(), {0, 0, thumbnail_dims.width_blk, thumbnail_dims.height_blk})) {
+
+                std::filesystem::create_directory(output_dir);
+                const std::string stem = file_path.stem();
+
+                if (!write_as_ppm(output_dir / (stem + "_" + thumbnail_dims.to_str() + ".ppm"), decoded_img.get(), thumbnail_dims.width_px, thumbnail_dims.height_px)) {
+
+                    ++tests_failed;
+                    std::cout << ": FAILED writing output\n";
+                }
+
+                else {
+
+                    std::cout << ": PASSED (tentative)\n";
+                }
+            }
+
+            else {
+
+                ++tests_failed;
+                std::cout << ": FAILED decoding JPEG\n";
+            }
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint thresholded_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                                const std::filesystem::path& test_imgs_dir,
+                                const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    assert(src_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 8)");
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    const uint32_t mask_size = src_dims.width_blk * src_dims.height_px;
+    const uint32_t img_size = src_dims.width_px * src_dims.height_px;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Thresholded decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> mask = std::make_unique<uint8_t[]>(mask_size);
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(img_size);
+
+        mdjpeg::ThresholdingBlockWriter writer;
+        bool subtest_passed = true;
+
+        for (const bool is_adaptive : {false, true}) {
+
+            writer.set_adaptive(is_adaptive, 0, 16);
+
+            if (!decoder.luma_decode(mask.get(), {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+                ++tests_failed;
+                subtest_passed = false;
+                std::cout << ": FAILED decoding JPEG\n";
+                break;
+            }
+
+            // unpack the mask to black and white pixels
+            for (uint32_t i = 0; i < img_size; ++i) {
+
+                decoded_img[i] = (mask[i / 8] >> (7 - i % 8) & 1) ? 255 : 0;
+            }
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = std::string(file_path.stem()) + (is_adaptive ? "_adaptive" : "_global") + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), src_dims.width_px, src_dims.height_px)) {
+
+                ++tests_failed;
+                subtest_passed = false;
+                std::cout << ": FAILED writing output\n";
+                break;
+            }
+        }
+
+        if (subtest_passed) {
+
+            std::cout << ": PASSED (tentative)\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint statistics_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                               const std::filesystem::path& test_imgs_dir,
+                               const uint16_t tile_size_blk) {
+
+    using namespace mdjpeg::test_utils;
+    using Moments = mdjpeg::StatisticsBlockWriter::Moments;
+    using Statistics = mdjpeg::StatisticsBlockWriter::Statistics;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+
+    const uint32_t tile_size_px = 8u * tile_size_blk;
+    const uint16_t width_tiles = (src_dims.width_px + tile_size_px - 1) / tile_size_px;
+    const uint16_t height_tiles = (src_dims.height_px + tile_size_px - 1) / tile_size_px;
+
+    const auto is_equal = [](const Moments& lhs, const Moments& rhs) {
+
+        return lhs.count == rhs.count && lhs.sum == rhs.sum
+                                      && lhs.sum_sq == rhs.sum_sq
+                                      && lhs.min == rhs.min
+                                      && lhs.max == rhs.max;
+    };
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Statistics decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(src_dims.width_px * src_dims.height_px);
+        std::unique_ptr<Moments[]> tiles = std::make_unique<Moments[]>(width_tiles * height_tiles);
+
+        mdjpeg::StatisticsBlockWriter writer;
+        writer.set_tiles(tiles.get(), tile_size_blk);
+
+        if (!decoder.luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk})
+            || !decoder.luma_decode(nullptr, {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+            delete[] buff;
+            continue;
+        }
+
+        // compute reference statistics from fully decompressed image
+        Statistics ref_statistics {};
+        std::unique_ptr<Moments[]> ref_tiles = std::make_unique<Moments[]>(width_tiles * height_tiles);
+
+        for (uint row = 0; row < src_dims.height_px; ++row) {
+
+            for (uint col = 0; col < src_dims.width_px; ++col) {
+
+                const uint8_t value = decoded_img[row * src_dims.width_px + col];
+
+                for (Moments* moments : {static_cast<Moments*>(&ref_statistics), &ref_tiles[(row / tile_size_px) * width_tiles + col / tile_size_px]}) {
+
+                    ++moments->count;
+                    moments->sum += value;
+                    moments->sum_sq += value * value;
+                    moments->min = std::min(moments->min, value);
+                    moments->max = std::max(moments->max, value);
+                }
+
+                ++ref_statistics.histogram[value];
+            }
+        }
+
+        const Statistics& statistics = writer.get_statistics();
+        bool subtest_passed = is_equal(statistics, ref_statistics)
+                              && std::equal(std::begin(statistics.histogram), std::end(statistics.histogram), std::begin(ref_statistics.histogram));
+
+        for (uint i = 0; i < static_cast<uint>(width_tiles * height_tiles); ++i) {
+
+            subtest_passed = subtest_passed && is_equal(tiles[i], ref_tiles[i]);
+        }
+
+        if (subtest_passed) {
+
+            std::cout << ": PASSED (mean = " << statistics.mean() << ", variance = " << statistics.variance() << ")\n";
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED matching reference statistics\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint integral_image_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                                   const std::filesystem::path& test_imgs_dir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+
+    const uint32_t pitch = src_dims.width_px + 1;
+    const uint32_t table_size = pitch * (src_dims.height_px + 1);
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Integral image decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(src_dims.width_px * src_dims.height_px);
+        std::unique_ptr<uint32_t[]> sums = std::make_unique<uint32_t[]>(table_size);
+        std::unique_ptr<uint64_t[]> squared_sums = std::make_unique<uint64_t[]>(table_size);
+
+        mdjpeg::IntegralImageBlockWriter writer;
+        writer.set_tables(sums.get(), squared_sums.get());
+
+        if (!decoder.luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk})
+            || !decoder.luma_decode(nullptr, {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+            delete[] buff;
+            continue;
+        }
+
+        // compute reference tables from fully decompressed image
+        std::unique_ptr<uint32_t[]> ref_sums = std::make_unique<uint32_t[]>(table_size);
+        std::unique_ptr<uint64_t[]> ref_squared_sums = std::make_unique<uint64_t[]>(table_size);
+
+        for (uint row = 0; row < src_dims.height_px; ++row) {
+
+            for (uint col = 0; col < src_dims.width_px; ++col) {
+
+                const uint32_t value = decoded_img[row * src_dims.width_px + col];
+                const uint32_t idx = (row + 1) * pitch + col + 1;
+
+                ref_sums[idx] = value + ref_sums[idx - 1] + ref_sums[idx - pitch] - ref_sums[idx - pitch - 1];
+                ref_squared_sums[idx] = value * value + ref_squared_sums[idx - 1] + ref_squared_sums[idx - pitch] - ref_squared_sums[idx - pitch - 1];
+            }
+        }
+
+        bool subtest_passed = std::equal(sums.get(), sums.get() + table_size, ref_sums.get())
+                              && std::equal(squared_sums.get(), squared_sums.get() + table_size, ref_squared_sums.get());
+
+        // band-wise path
+        std::unique_ptr<uint8_t[]> band_buff = std::make_unique<uint8_t[]>(64 * src_dims.width_blk);
+
+        subtest_passed = subtest_passed
+                         && decoder.luma_decode(nullptr, {0, 0, src_dims.width_blk, src_dims.height_blk}, writer, band_buff.get())
+                         && std::equal(sums.get(), sums.get() + table_size, ref_sums.get())
+                         && std::equal(squared_sums.get(), squared_sums.get() + table_size, ref_squared_sums.get());
+
+        if (subtest_passed) {
+
+            std::cout << ": PASSED (total = " << sums[table_size - 1] << ")\n";
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED matching reference integral image\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+uint composite_decoding_tests(const mdjpeg::test_utils::Dimensions& src_dims,
+                              const std::filesystem::path& test_imgs_dir,
+                              const std::filesystem::path& output_subdir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const Dimensions thumb_dims {static_cast<uint16_t>(src_dims.width_px / 4),
+                                 static_cast<uint16_t>(src_dims.height_px / 4)};
+
+    assert(thumb_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 32)");
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Composite decoding test on \"" << file_path.filename().c_str() << "\"";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(src_dims.width_px * src_dims.height_px);
+        std::unique_ptr<uint8_t[]> decoded_thumb = std::make_unique<uint8_t[]>(thumb_dims.width_px * thumb_dims.height_px);
+
+        mdjpeg::BasicBlockWriter full_scale_writer;
+        mdjpeg::IntegralDownscalingBlockWriter<4> downscaling_writer;
+        mdjpeg::CompositeBlockWriter<2> writer;
+        writer.attach(full_scale_writer, decoded_img.get());
+        writer.attach(downscaling_writer, decoded_thumb.get());
+
+        if (decoder.luma_decode(nullptr, {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = file_path.filename().replace_extension("pgm");
+            const std::filesystem::path thumb_filename = std::string(file_path.stem()) + "_" + thumb_dims.to_str() + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), src_dims.width_px, src_dims.height_px)
+                || !write_as_pgm(output_dir / thumb_filename, decoded_thumb.get(), thumb_dims.width_px, thumb_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
@@ -8,13 +8,25 @@
 #include <iostream>
 
 #include "../JpegDecoder.h"
+#include "../BasicBlockWriter.h"
+#include "../StatisticsBlockWriter.h"
+#include "../ThresholdingBlockWriter.h"
+#include "../IntegralImageBlockWriter.h"
+#include "../CompositeBlockWriter.h"
+#include "../IntegralDownscalingBlockWriter.h"
 #include "../DownscalingBlockWriter.h"
+#include "../TensorBlockWriter.h"
+#include "../TilingBlockWriter.h"
+#include "../OrientingBlockWriter.h"
+#include "../FilteringBlockWriter.h"
+#include "../RgbBlockWriter.h"
+#include "../YuvBlockWriter.h"
 #include "test-utils.h"
 
 
 /// \brief Tests full frame, 1/8-scale (DC only) decompression on a batch of JPEG images.
 ///
-/// \param src_dims       Input images width and height, both must be multiples of 8.
+/// \param src_dims       Input images width and height.
 /// \param test_imgs_dir  Base directory for test images.
 /// \param output_subdir  Subdirectory for diagnostic output.
 /// \return               Total count of failed tests in this batch.
@@ -22,7 +34,7 @@
 /// Specifically tests JpegDecoder::dc_luma_decode in full frame mode. Images
 /// matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
 /// are processed individually by decompressing them directly to 1/8 of their
-/// original width and height. The resulting scaled-down luma-only images are
+/// original width and height (rounded up). The resulting scaled-down luma-only images are
 /// written to "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PGM format. The
 /// output directory is created if it does not exist.
 ///
@@ -53,9 +65,43 @@ uint full_frame_dc_decoding_tests(
     const std::filesystem::path& output_subdir = "decoded_DC-only"
 );
 
+/// \brief Tests full frame, 1/8-scale (DC only) color decompression on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::dc_color_decode in full frame mode. Images
+/// matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing each one directly to 1/8 of
+/// its original width and height (rounded up) twice, in RGB888 and in
+/// Y'CbCr. The resulting images are written to
+/// "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PPM format, Y'CbCr
+/// triplets in place of RGB ones. The output directory is created if it does
+/// not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing any of the output images to the filesystem fails. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+uint full_frame_dc_color_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_DC-only_color"
+);
+
 /// \brief Tests full frame, 1:1 scale decompression on a batch of JPEG images.
 ///
-/// \param src_dims       Input images width and height, both must be multiples of 8.
+/// \param src_dims       Input images width and height.
 /// \param test_imgs_dir  Base directory for test images.
 /// \param output_subdir  Subdirectory for diagnostic output.
 /// \return               Total count of failed tests in this batch.
@@ -85,6 +131,41 @@ uint full_frame_decoding_tests(
     const std::filesystem::path& output_subdir = "decoded_full_scale"
 );
 
+/// \brief Tests full frame, 1:1 scale band-wise decompression on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode in full frame mode with a
+/// staging buffer, i.e. via BlockWriter::write_rows. Otherwise identical to
+/// full_frame_decoding_tests, including the expected output.
+uint full_frame_band_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_full_scale_banded"
+);
+
+/// \brief Tests full frame, 1:1 scale decompression with tables reused across frames on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests reuse of quantization and %Huffman tables by a single
+/// JpegDecoder assigned all images of the batch in turn, twice over (as frames
+/// of an MJPEG stream). \e DQT and \e DHT segments of every image are
+/// overwritten right after assignment, so decompression relies on the copies
+/// of the tables alone. Otherwise identical to full_frame_decoding_tests,
+/// including the expected output.
+uint reused_tables_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_reused_tables"
+);
+
 /// \brief Tests cropped frame, 1:1 scale decompression on a batch of JPEG images.
 ///
 /// \param src_dims       Input images width and height, both must be multiples of 8.
@@ -118,6 +199,383 @@ uint cropped_decoding_tests(
     const std::filesystem::path& output_subdir = "decoded_cropped"
 );
 
+/// \brief Tests pixel-accurate cropped frame decompression on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height, both must be multiples of 8.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode_px injected with
+/// CompositeBlockWriter of BasicBlockWriter and DownscalingBlockWriter<64, 48>.
+/// Images matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing a single region of interest
+/// whose borders are not aligned with blocks (except for the bottom one which
+/// is 3 pixels above the image edge) both in 1:1 scale and downscaled to 64x48
+/// pixels. The resulting luma-only images are written to
+/// "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PGM format. The output
+/// directory is created if it does not exist. The same region of interest is
+/// also requested via ThresholdingBlockWriter, which does not support cropping
+/// and must therefore be rejected.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails,
+/// because the writer without cropping support is not rejected or because
+/// writing any of the output images to the filesystem fails. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+uint pixel_cropped_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_cropped_px"
+);
+
+/// \brief Tests strided block-sampling decompression on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height, both must be multiples of 8.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param stride         Distance between sample blocks expressed in blocks.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::strided_luma_decode in full frame mode.
+/// Images matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing every \c stride-th block of
+/// every \c stride-th row of blocks. The resulting luma-only images of
+/// compacted sample blocks are written to "`test_imgs_dir`/`output_subdir`"
+/// in 8-bit ASCII PGM format. The output directory is created if it does not
+/// exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing the output image to the filesystem fails. The cause of
+/// failure is reported to stdout per image basis and the failed tests counter
+/// is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+uint strided_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    uint8_t stride,
+    const std::filesystem::path& output_subdir = "decoded_strided"
+);
+
+/// \brief Tests single pass foveated decompression on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height, both must be multiples of 32.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::foveated_luma_decode. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing each one into a 1:8 scale overview
+/// of the whole frame and three 1:1 scale subimages, all in a single pass. The
+/// subimages are the "5" and "A" tiles of the 4 x 4 grid used by
+/// cropped_decoding_tests and the "5" and "6" tiles merged (overlapping the
+/// former). The resulting luma-only images are written to
+/// "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PGM format. The output
+/// directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing any of the output images to the filesystem fails. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input image
+/// Example input image is provided along with checksums of expected output
+/// (identical to those of full_frame_dc_decoding_tests and
+/// cropped_decoding_tests where applicable). Output of tests that passed
+/// tentatively should be validated against the checksums by running `make
+/// tests-validate` to obtain the final passed/failed verdict.
+uint foveated_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_foveated"
+);
+
+/// \brief Tests mosaic assembly of cropped, 1:1 scale decompressions on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height, both must be multiples of 32.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode in crop mode with the
+/// destination layout set via BlockWriter::set_dst_layout. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing each one as 16 subimages tiled on a
+/// 4 x 4 grid, every one of them directly into its place within a single
+/// canvas. This is done three times: at 1:1 scale with BasicBlockWriter, at
+/// 1:2 scale with IntegralDownscalingBlockWriter<2> and as a binary mask with
+/// ThresholdingBlockWriter (destination layout expressed in bytes). The
+/// resulting luma-only images (the mask unpacked to black and white pixels)
+/// are written to "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PGM
+/// format. The output directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression of any
+/// of the subimages fails or because writing the output image to the
+/// filesystem fails. The cause of failure is reported to stdout per image
+/// basis and the failed tests counter is incremented by one. Otherwise, the
+/// test passes tentatively and is reported to stdout as such.
+///
+/// \par Example input image
+/// Example input image is provided along with checksums of expected outputs
+/// (identical to those of full_frame_decoding_tests,
+/// integral_downscaling_decoding_test and thresholded_decoding_tests with
+/// global threshold). Output of tests that passed tentatively should be
+/// validated against the checksums by running `make tests-validate` to obtain
+/// the final passed/failed verdict.
+uint mosaic_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_mosaic"
+);
+
+/// \brief Tests color decompression on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::color_decode injected with RgbBlockWriter.
+/// Images matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing each one into three images:
+/// the full frame in RGB888 and in RGB565 format, and a cropped frame in
+/// RGB888 format, inset by one block on each side (i.e. starting in the middle
+/// of a 4:2:2 minimum coded unit). RGB565 output is expanded to 8 bits per
+/// channel by bit replication. The resulting images are written to
+/// "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PPM format. The output
+/// directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing any of the output images to the filesystem fails. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+uint color_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_color"
+);
+
+/// \brief Tests decompression to Y'CbCr frames for video encoders on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height, both must be even.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::color_decode injected with YuvBlockWriter.
+/// Images matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing each one into three frames,
+/// in I420, NV12 and YUYV format. Raw frames are written to
+/// "`test_imgs_dir`/`output_subdir`" as 8-bit grayscale PGM images, planar
+/// and semi-planar frames as images of `src_dims.height_px * 3 / 2` rows
+/// (planes stacked on top of each other) and YUYV frames as images of
+/// `src_dims.width_px * 2` columns. Odd input dimensions are rounded up to
+/// even ones, same as by YuvBlockWriter. The output directory is created if it
+/// does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing any of the output images to the filesystem fails. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+uint yuv_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_yuv"
+);
+
+/// \brief Tests decompression of JPEG thumbnails embedded in EXIF metadata on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::get_thumbnail and
+/// JpegDecoder::assign_thumbnail. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing their embedded thumbnails, if any,
+/// in full frame color mode (see JpegDecoder::color_decode). The resulting
+/// RGB888 images, named after the thumbnail dimensions, are written to
+/// "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PPM format. The output
+/// directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// Images without an embedded thumbnail are reported to stdout as skipped. A
+/// test can fail on a particular image either because decompression of its
+/// thumbnail fails or because writing the output image to the filesystem fails.
+/// The cause of failure is reported to stdout per image basis and the failed
+/// tests counter is incremented by one. Otherwise, the test passes tentatively
+/// and is reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+uint thumbnail_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_thumbnail"
+);
+
+/// \brief Tests full frame decompression to bit-packed binary masks on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height, both must be multiples of 8.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// ThresholdingBlockWriter in full frame mode. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing each one into two masks, one using
+/// the global threshold of 127 and one using adaptive thresholding against
+/// block means (offset 0, min contrast 16). The masks are unpacked to black
+/// and white luma-only images written to "`test_imgs_dir`/`output_subdir`" in
+/// 8-bit ASCII PGM format. The output directory is created if it does not
+/// exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing any of the output images to the filesystem fails. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+uint thresholded_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_thresholded"
+);
+
+/// \brief Tests full frame luma statistics gathering on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param tile_size_blk  Tile size for per-tile statistics expressed in 8x8 blocks.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// StatisticsBlockWriter in full frame mode, including cropping of padding
+/// pixels for dimensions that are not multiples of 8. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by gathering their per-frame and per-tile statistics
+/// which are then compared against those computed from the same image fully
+/// decompressed to a raw pixel buffer.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because any of the gathered statistics differs from the reference. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes and is reported to
+/// stdout as such.
+uint statistics_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    uint16_t tile_size_blk = 4
+);
+
+/// \brief Tests full frame integral image computation on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height.
+/// \param test_imgs_dir  Base directory for test images.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// IntegralImageBlockWriter in full frame mode, including cropping of padding
+/// pixels for dimensions that are not multiples of 8. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by computing their integral images of pixel values
+/// and of squared pixel values, both block-wise and band-wise, which are then
+/// compared against those computed from the same image fully decompressed to a
+/// raw pixel buffer.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because any of the table entries differs from the reference. The cause of
+/// failure is reported to stdout per image basis and the failed tests counter
+/// is incremented by one. Otherwise, the test passes and is reported to stdout
+/// as such.
+uint integral_image_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir
+);
+
+/// \brief Tests full frame decompression to multiple outputs at once on a batch of JPEG images.
+///
+/// \param src_dims       Input images width and height, both must be multiples of 32.
+/// \param test_imgs_dir  Base directory for test images.
+/// \param output_subdir  Subdirectory for diagnostic output.
+/// \return               Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// CompositeBlockWriter in full frame mode. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing each one in a single pass both in
+/// full scale (via BasicBlockWriter) and in 1/4 scale (via
+/// IntegralDownscalingBlockWriter). The resulting pairs of luma-only images are
+/// written to "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PGM format. The
+/// output directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing any of the output images to the filesystem fails. The cause
+/// of failure is reported to stdout per image basis and the failed tests
+/// counter is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output
+/// (identical to those of full_frame_decoding_tests and
+/// integral_downscaling_decoding_test). Output of tests that passed
+/// tentatively should be validated against the checksums by running `make
+/// tests-validate` to obtain the final passed/failed verdict.
+uint composite_decoding_tests(
+    const mdjpeg::test_utils::Dimensions& src_dims,
+    const std::filesystem::path& test_imgs_dir,
+    const std::filesystem::path& output_subdir = "decoded_composite"
+);
+
 /// \brief Tests downscaling on a homogeneous frame buffer.
 ///
 /// \tparam SRC_WIDTH_PX   Input frame buffer width in pixels, must be a multiple of 8.
@@ -396,3 +854,539 @@ uint recursive_downscaling_decoding_test(const std::filesystem::path& test_imgs_
 
     return tests_failed;
 }
+
+/// \brief Tests full frame, band-wise decompression with downscaling on a batch of JPEG images.
+///
+/// \tparam DST_WIDTH_PX   Output image width in pixels, must be no greater than the input width.
+/// \tparam DST_HEIGHT_PX  Output image height in pixels, must be no greater than the input height.
+/// \param  src_dims       Input images width and height.
+/// \param  test_imgs_dir  Base directory for test images.
+/// \return                Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// DownscalingBlockWriter<DST_WIDTH_PX, DST_HEIGHT_PX> in full frame mode with
+/// a staging buffer. DownscalingBlockWriter only provides write(), so bands
+/// reach it through the default adapter BlockWriter::write_rows. Images
+/// matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing them both band-wise and
+/// block-wise, and the two outputs are compared.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because the band-wise output differs from the block-wise one. The cause of
+/// failure is reported to stdout per image basis and the failed tests counter
+/// is incremented by one. Otherwise, the test passes and is reported to stdout
+/// as such.
+template <uint16_t DST_WIDTH_PX, uint16_t DST_HEIGHT_PX>
+uint downscaling_band_decoding_test(const mdjpeg::test_utils::Dimensions& src_dims,
+                                    const std::filesystem::path& test_imgs_dir) {
+
+    using namespace mdjpeg::test_utils;
+
+    const Dimensions dst_dims {DST_WIDTH_PX, DST_HEIGHT_PX};
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Downscaling band decoding test on \"" << file_path.filename().c_str() << "\""
+                  << " (" << src_dims.to_str() << " -> " << dst_dims.to_str() << ")";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        mdjpeg::DownscalingBlockWriter<DST_WIDTH_PX, DST_HEIGHT_PX> writer;
+
+        uint8_t decoded_img[DST_WIDTH_PX * DST_HEIGHT_PX] {};
+        uint8_t ref_img[DST_WIDTH_PX * DST_HEIGHT_PX] {};
+        std::unique_ptr<uint8_t[]> band_buff = std::make_unique<uint8_t[]>(64 * src_dims.width_blk);
+
+        if (!decoder.luma_decode(decoded_img, {0, 0, src_dims.width_blk, src_dims.height_blk}, writer, band_buff.get())
+            || !decoder.luma_decode(ref_img, {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        else if (!std::equal(std::begin(decoded_img), std::end(decoded_img), std::begin(ref_img))) {
+
+            ++tests_failed;
+            std::cout << ": FAILED matching block-wise output\n";
+        }
+
+        else {
+
+            std::cout << ": PASSED\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+/// \brief Tests full frame, integrally downscaled decompression on a batch of JPEG images.
+///
+/// \tparam FACTOR         Downscaling factor, one of 2, 4 or 8.
+/// \param  src_dims       Input images width and height, both must be multiples of 8.
+/// \param  test_imgs_dir  Base directory for test images.
+/// \param  output_subdir  Subdirectory for diagnostic output.
+/// \return                Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// IntegralDownscalingBlockWriter<FACTOR> in full frame mode. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing them to 1/`FACTOR` of their original
+/// width and height. The resulting scaled-down luma-only images are written to
+/// "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PGM format. The output
+/// directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing the output image to the filesystem fails. The cause of
+/// failure is reported to stdout per image basis and the failed tests counter
+/// is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final passed/failed
+/// verdict.
+template <uint8_t FACTOR>
+uint integral_downscaling_decoding_test(const mdjpeg::test_utils::Dimensions& src_dims,
+                                        const std::filesystem::path& test_imgs_dir,
+                                        const std::filesystem::path& output_subdir = "decoded_integral_downscaled") {
+
+    using namespace mdjpeg::test_utils;
+
+    assert(src_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 8)");
+
+    const Dimensions dst_dims {static_cast<uint16_t>(src_dims.width_px / FACTOR),
+                               static_cast<uint16_t>(src_dims.height_px / FACTOR)};
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Integral downscaling decoding test on \"" << file_path.filename().c_str() << "\""
+                  << " (" << src_dims.to_str() << " -> " << dst_dims.to_str() << ")";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        mdjpeg::IntegralDownscalingBlockWriter<FACTOR> writer;
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(dst_dims.width_px * dst_dims.height_px);
+
+        if (decoder.luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = std::string(file_path.stem()) + "_" + dst_dims.to_str() + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), dst_dims.width_px, dst_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding+downscaling JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+/// \brief Tests full frame, 1:1 scale decompression to tiled layout on a batch of JPEG images.
+///
+/// \tparam TILE_SIZE_PX   Width and height of a tile in pixels, one of 8, 16 or 32.
+/// \tparam Z_ORDER        Whether tiles are laid out in Z-order.
+/// \param  src_dims       Input images width and height, both must be multiples of 8.
+/// \param  test_imgs_dir  Base directory for test images.
+/// \param  output_subdir  Subdirectory for diagnostic output.
+/// \return                Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// TilingBlockWriter<TILE_SIZE_PX, Z_ORDER> in full frame mode. Images
+/// matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing them to tiled layout which is
+/// then converted back to raster layout by TilingBlockWriter::to_raster. The
+/// resulting luma-only images are written to "`test_imgs_dir`/`output_subdir`"
+/// in 8-bit ASCII PGM format. The output directory is created if it does not
+/// exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing the output image to the filesystem fails. The cause of
+/// failure is reported to stdout per image basis and the failed tests counter
+/// is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output
+/// (identical to those of full_frame_decoding_tests). Output of tests that
+/// passed tentatively should be validated against the checksums by running
+/// `make tests-validate` to obtain the final passed/failed verdict.
+template <uint8_t TILE_SIZE_PX, bool Z_ORDER>
+uint tiled_decoding_test(const mdjpeg::test_utils::Dimensions& src_dims,
+                         const std::filesystem::path& test_imgs_dir,
+                         const std::filesystem::path& output_subdir = "decoded_tiled") {
+
+    using namespace mdjpeg::test_utils;
+    using Writer = mdjpeg::TilingBlockWriter<TILE_SIZE_PX, Z_ORDER>;
+
+    assert(src_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 8)");
+
+    const std::string layout_str = std::to_string(TILE_SIZE_PX) + (Z_ORDER ? "_z-order" : "_raster");
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Tiled decoding test on \"" << file_path.filename().c_str() << "\" (" << layout_str << ")";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        Writer writer;
+        std::unique_ptr<uint8_t[]> tiled_img = std::make_unique<uint8_t[]>(Writer::buffer_size(src_dims.width_px, src_dims.height_px));
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(src_dims.width_px * src_dims.height_px);
+
+        if (decoder.luma_decode(tiled_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            Writer::to_raster(tiled_img.get(), decoded_img.get(), src_dims.width_px, src_dims.height_px);
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = std::string(file_path.stem()) + "_" + layout_str + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), src_dims.width_px, src_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+/// \brief Tests full frame decompression with rotation or mirroring on a batch of JPEG images.
+///
+/// \tparam ORIENTATION    Output orientation.
+/// \tparam FACTOR         Integral downscaling factor, one of 1, 2, 4 or 8.
+/// \param  src_dims       Input images width and height.
+/// \param  test_imgs_dir  Base directory for test images.
+/// \param  output_subdir  Subdirectory for diagnostic output.
+/// \return                Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// OrientingBlockWriter<ORIENTATION, FACTOR> in full frame mode, including
+/// cropping of padding pixels for dimensions that are not multiples of 8. Images
+/// matching "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg"
+/// are processed individually by decompressing them directly into the
+/// requested orientation. The resulting luma-only images are written to
+/// "`test_imgs_dir`/`output_subdir`" in 8-bit ASCII PGM format. The output
+/// directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing the output image to the filesystem fails. The cause of
+/// failure is reported to stdout per image basis and the failed tests counter
+/// is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+template <mdjpeg::Orientation ORIENTATION, uint8_t FACTOR = 1>
+uint oriented_decoding_test(const mdjpeg::test_utils::Dimensions& src_dims,
+                            const std::filesystem::path& test_imgs_dir,
+                            const std::filesystem::path& output_subdir = "decoded_oriented") {
+
+    using namespace mdjpeg::test_utils;
+
+    const std::string orientation_str = std::to_string(static_cast<uint>(ORIENTATION));
+
+    // dimensions not multiples of FACTOR are rounded up (see OrientingBlockWriter)
+    const uint32_t dst_area_px = static_cast<uint32_t>((src_dims.width_px + FACTOR - 1) / FACTOR) * ((src_dims.height_px + FACTOR - 1) / FACTOR);
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Oriented decoding test on \"" << file_path.filename().c_str() << "\""
+                  << " (orientation " << orientation_str << ", 1:" << static_cast<uint>(FACTOR) << " scale)";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        mdjpeg::OrientingBlockWriter<ORIENTATION, FACTOR> writer;
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(dst_area_px);
+
+        if (decoder.luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            const Dimensions dst_dims {writer.get_dst_width_px(), writer.get_dst_height_px()};
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = std::string(file_path.stem()) + "_" + orientation_str + "_" + dst_dims.to_str() + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), dst_dims.width_px, dst_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+/// \brief Tests full frame decompression to model input tensors on a batch of JPEG images.
+///
+/// \tparam DST_WIDTH_PX   Width of the tensor's images in pixels.
+/// \tparam DST_HEIGHT_PX  Height of the tensor's images in pixels.
+/// \param  src_dims       Input images width and height, both must be multiples of 8.
+/// \param  test_imgs_dir  Base directory for test images.
+/// \return                Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with TensorBlockWriter
+/// in full frame mode. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing them into the second slot of a
+/// normalized 3-channel float tensor in NCHW layout and into a quantized
+/// 1-channel int8 tensor in NHWC layout. Both tensors are then compared
+/// against the corresponding transformation of the same image decompressed by
+/// DownscalingBlockWriter<DST_WIDTH_PX, DST_HEIGHT_PX>.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because any of the tensor elements differs from the reference by more than
+/// the rounding error of the reference (the first slot of the float tensor
+/// must stay untouched). The cause of failure is reported to stdout per image
+/// basis and the failed tests counter is incremented by one. Otherwise, the
+/// test passes and is reported to stdout as such.
+template <uint16_t DST_WIDTH_PX, uint16_t DST_HEIGHT_PX>
+uint tensor_decoding_test(const mdjpeg::test_utils::Dimensions& src_dims,
+                          const std::filesystem::path& test_imgs_dir) {
+
+    using namespace mdjpeg::test_utils;
+
+    assert(src_dims.is_8x8_multiple() && "invalid input dimensions (not multiples of 8)");
+
+    constexpr uint32_t plane_size = DST_WIDTH_PX * DST_HEIGHT_PX;
+    constexpr float mean[3] {123.675f, 116.28f, 103.53f};
+    constexpr float std[3] {58.395f, 57.12f, 57.375f};
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Tensor decoding test on \"" << file_path.filename().c_str() << "\""
+                  << " (" << src_dims.to_str() << " -> " << DST_WIDTH_PX << "x" << DST_HEIGHT_PX << ")";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        const mdjpeg::BoundingBox roi {0, 0, src_dims.width_blk, src_dims.height_blk};
+
+        std::unique_ptr<uint8_t[]> ref_img = std::make_unique<uint8_t[]>(plane_size);
+        std::unique_ptr<float[]> float_tensor = std::make_unique<float[]>(2 * 3 * plane_size);
+        std::unique_ptr<int8_t[]> int8_tensor = std::make_unique<int8_t[]>(plane_size);
+
+        mdjpeg::DownscalingBlockWriter<DST_WIDTH_PX, DST_HEIGHT_PX> ref_writer;
+
+        mdjpeg::TensorBlockWriter<float, DST_WIDTH_PX, DST_HEIGHT_PX, mdjpeg::TensorLayout::NCHW, 3> float_writer;
+        float_writer.get_output().set_tensor(float_tensor.get(), 1);
+        float_writer.get_output().set_normalization(mean, std);
+
+        // [0, 255] -> [0, 1] -> [-128, 127]
+        mdjpeg::TensorBlockWriter<int8_t, DST_WIDTH_PX, DST_HEIGHT_PX> int8_writer;
+        int8_writer.get_output().set_tensor(int8_tensor.get());
+        int8_writer.get_output().set_normalization({0.0f}, {255.0f});
+        int8_writer.get_output().set_quantization(1.0f / 255.0f, -128);
+
+        if (!decoder.luma_decode(ref_img.get(), roi, ref_writer)
+            || !decoder.luma_decode(nullptr, roi, float_writer)
+            || !decoder.luma_decode(nullptr, roi, int8_writer)) {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+            delete[] buff;
+            continue;
+        }
+
+        bool subtest_passed = true;
+
+        for (uint32_t i = 0; i < plane_size; ++i) {
+
+            subtest_passed = subtest_passed && float_tensor[i] == 0.0f
+                                            && float_tensor[plane_size + i] == 0.0f
+                                            && float_tensor[2 * plane_size + i] == 0.0f;
+
+            for (uint c = 0; c < 3; ++c) {
+
+                const float expected = (ref_img[i] - mean[c]) / std[c];
+                subtest_passed = subtest_passed && std::abs(float_tensor[(3 + c) * plane_size + i] - expected) <= 0.501f / std[c];
+            }
+
+            subtest_passed = subtest_passed && std::abs(int8_tensor[i] - (ref_img[i] - 128)) <= 1;
+        }
+
+        if (subtest_passed) {
+
+            std::cout << ": PASSED\n";
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED matching reference tensors\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
+
+/// \brief Tests full frame, 1:1 scale decompression with filtering on a batch of JPEG images.
+///
+/// \tparam FILTER         Filter to apply.
+/// \param  src_dims       Input images width and height, width no greater than 800.
+/// \param  test_imgs_dir  Base directory for test images.
+/// \param  output_subdir  Subdirectory for diagnostic output.
+/// \return                Total count of failed tests in this batch.
+///
+/// Specifically tests JpegDecoder::luma_decode injected with
+/// FilteringBlockWriter<FILTER, 800> in full frame mode, including cropping of
+/// padding pixels for dimensions that are not multiples of 8. Images matching
+/// "`test_imgs_dir`/`src_dims.width_px`x`src_dims.height_px`/*.jpg" are
+/// processed individually by decompressing and filtering them. The resulting
+/// luma-only images are written to "`test_imgs_dir`/`output_subdir`" in 8-bit
+/// ASCII PGM format. The output directory is created if it does not exist.
+///
+/// \par PASSED/FAILED criteria, reporting
+/// A test can fail on a particular image either because decompression fails or
+/// because writing the output image to the filesystem fails. The cause of
+/// failure is reported to stdout per image basis and the failed tests counter
+/// is incremented by one. Otherwise, the test passes tentatively and is
+/// reported to stdout as such.
+///
+/// \par Example input images
+/// Example input images are provided along with checksums of expected output.
+/// Output of tests that passed tentatively should be validated against the
+/// checksums by running `make tests-validate` to obtain the final
+/// passed/failed verdict.
+template <mdjpeg::Filter FILTER>
+uint filtered_decoding_test(const mdjpeg::test_utils::Dimensions& src_dims,
+                            const std::filesystem::path& test_imgs_dir,
+                            const std::filesystem::path& output_subdir = "decoded_filtered") {
+
+    using namespace mdjpeg::test_utils;
+
+    assert(src_dims.width_px <= 800 && "invalid input dimensions (wider than 800)");
+
+    const std::string filter_str = FILTER == mdjpeg::Filter::GAUSSIAN_5X5 ? "gaussian"
+                                   : FILTER == mdjpeg::Filter::SOBEL_MAGNITUDE ? "sobel_magnitude"
+                                   : "sobel_direction";
+
+    const auto input_files_dir = test_imgs_dir / src_dims.to_str();
+    const auto input_files_paths = get_input_img_paths(input_files_dir);
+    const auto output_dir = input_files_dir / output_subdir;
+
+    uint tests_failed = 0;
+
+    for (const auto& file_path : input_files_paths) {
+
+        std::cout << "Filtered decoding test on \"" << file_path.filename().c_str() << "\" (" << filter_str << ")";
+
+        const auto [buff, size] = read_raw_jpeg_from_file(file_path);
+        mdjpeg::JpegDecoder decoder;
+        decoder.assign(buff, size);
+        mdjpeg::FilteringBlockWriter<FILTER, 800> writer;
+        std::unique_ptr<uint8_t[]> decoded_img = std::make_unique<uint8_t[]>(src_dims.width_px * src_dims.height_px);
+
+        if (decoder.luma_decode(decoded_img.get(), {0, 0, src_dims.width_blk, src_dims.height_blk}, writer)) {
+
+            std::filesystem::create_directory(output_dir);
+            const std::filesystem::path filename = std::string(file_path.stem()) + "_" + filter_str + ".pgm";
+
+            if (!write_as_pgm(output_dir / filename, decoded_img.get(), src_dims.width_px, src_dims.height_px)) {
+
+                ++tests_failed;
+                std::cout << ": FAILED writing output\n";
+            }
+
+            else {
+
+                std::cout << ": PASSED (tentative)\n";
+            }
+        }
+
+        else {
+
+            ++tests_failed;
+            std::cout << ": FAILED decoding JPEG\n";
+        }
+
+        delete[] buff;
+    }
+
+    return tests_failed;
+}
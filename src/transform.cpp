@@ -3,6 +3,10 @@
 #include <sys/types.h>
 #include <cmath>
 
+#ifdef __SSE2__
+    #include <emmintrin.h>
+#endif
+
 
 using namespace mdjpeg;
 
@@ -42,6 +46,72 @@ namespace IDCT {
     const float s7 = std::cos(7.0 / 16.0 * M_PI) / 2.0;
 }  // namespace IDCT
 
+namespace YCbCr {
+
+    // JFIF conversion coefficients in 14-bit fixed point
+    constexpr int fix_shift = 14;
+    constexpr int fix_half = 1 << (fix_shift - 1);
+    constexpr int r_cr = 22970;  // 1.402
+    constexpr int g_cb = 5638;   // 0.344136
+    constexpr int g_cr = 11700;  // 0.714136
+    constexpr int b_cb = 29032;  // 1.772
+
+    inline int saturate(const int value) noexcept {
+
+        return value < 0 ? 0 : (value > 255 ? 255 : value);
+    }
+
+    inline void to_rgb(const int y, int cb, int cr, int& r, int& g, int& b) noexcept {
+
+        cb -= 128;
+        cr -= 128;
+
+        r = saturate(y + ((r_cr * cr + fix_half) >> fix_shift));
+        g = saturate(y + ((-g_cb * cb - g_cr * cr + fix_half) >> fix_shift));
+        b = saturate(y + ((b_cb * cb + fix_half) >> fix_shift));
+    }
+
+    #ifdef __SSE2__
+        // converts 4 pixels, R, G and B end up in 32-bit lanes (not saturated yet)
+        inline void to_rgb_4px(const int* const y, const int* const cb, const int* const cr, __m128i& r, __m128i& g, __m128i& b) noexcept {
+
+            const __m128i bias = _mm_set1_epi32(128);
+            const __m128i half = _mm_set1_epi32(fix_half);
+            const __m128i y_4px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y));
+            const __m128i cb_4px = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cb)), bias);
+            const __m128i cr_4px = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cr)), bias);
+
+            // 16-bit (cb, cr) pairs, for a single multiply-add of both terms of G
+            const __m128i cbcr_4px = _mm_or_si128(_mm_and_si128(cb_4px, _mm_set1_epi32(0xffff)), _mm_slli_epi32(cr_4px, 16));
+
+            // products of 32-bit lanes' low halves, high halves are multiplied by zero
+            r = _mm_madd_epi16(cr_4px, _mm_set_epi16(0, r_cr, 0, r_cr, 0, r_cr, 0, r_cr));
+            g = _mm_madd_epi16(cbcr_4px, _mm_set_epi16(-g_cr, -g_cb, -g_cr, -g_cb, -g_cr, -g_cb, -g_cr, -g_cb));
+            b = _mm_madd_epi16(cb_4px, _mm_set_epi16(0, b_cb, 0, b_cb, 0, b_cb, 0, b_cb));
+
+            r = _mm_add_epi32(y_4px, _mm_srai_epi32(_mm_add_epi32(r, half), fix_shift));
+            g = _mm_add_epi32(y_4px, _mm_srai_epi32(_mm_add_epi32(g, half), fix_shift));
+            b = _mm_add_epi32(y_4px, _mm_srai_epi32(_mm_add_epi32(b, half), fix_shift));
+        }
+
+        // converts 8 pixels, R, G and B end up saturated in 16-bit lanes
+        inline void to_rgb_8px(const int* const y, const int* const cb, const int* const cr, __m128i& r, __m128i& g, __m128i& b) noexcept {
+
+            __m128i r_lo, g_lo, b_lo, r_hi, g_hi, b_hi;
+
+            to_rgb_4px(y, cb, cr, r_lo, g_lo, b_lo);
+            to_rgb_4px(y + 4, cb + 4, cr + 4, r_hi, g_hi, b_hi);
+
+            // saturate to 0 to 255 by packing to 8-bit lanes and back
+            const __m128i zero = _mm_setzero_si128();
+
+            r = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_packs_epi32(r_lo, r_hi), zero), zero);
+            g = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_packs_epi32(g_lo, g_hi), zero), zero);
+            b = _mm_unpacklo_epi8(_mm_packus_epi16(_mm_packs_epi32(b_lo, b_hi), zero), zero);
+        }
+    #endif
+}  // namespace YCbCr
+
 }  // namespace
 /// \endcond
 
@@ -204,23 +274,81 @@ void transform::idct(int (&block)[64]) noexcept {
     }
 }
 
-void transform::range_normalize(int (&block)[64]) noexcept {
+void transform::upsample(const int (&src_block)[64], const uint8_t horiz_factor, const uint8_t vert_factor,
+                         const uint8_t col, const uint8_t row, int (&dst_block)[64]) noexcept {
 
-    for (uint i = 0; i < 64; ++i) {
+    // factors are 1 or 2, i.e. shifts by 0 or 1
+    const uint8_t horiz_shift = horiz_factor - 1;
+    const uint8_t vert_shift = vert_factor - 1;
+
+    const int* const src = src_block + (row * 8 >> vert_shift) * 8 + (col * 8 >> horiz_shift);
+    uint dst_idx = 0;
+
+    for (uint dst_row = 0; dst_row < 8; ++dst_row) {
 
-        if (block[i] < -128) {
+        const int* const src_row = src + (dst_row >> vert_shift) * 8;
 
-            block[i] = 0;
+        for (uint dst_col = 0; dst_col < 8; ++dst_col) {
+
+            dst_block[dst_idx++] = src_row[dst_col >> horiz_shift];
         }
+    }
+}
 
-        else if (block[i] > 127) {
+void transform::ycbcr_to_rgb888(const int* y, const int* cb, const int* cr, uint8_t* dst, uint count) noexcept {
 
-            block[i] = 255;
+    #ifdef __SSE2__
+        for (; count >= 8; count -= 8, y += 8, cb += 8, cr += 8) {
+
+            __m128i r, g, b;
+            YCbCr::to_rgb_8px(y, cb, cr, r, g, b);
+
+            alignas(16) uint8_t rgb[3][16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(rgb[0]), _mm_packus_epi16(r, r));
+            _mm_store_si128(reinterpret_cast<__m128i*>(rgb[1]), _mm_packus_epi16(g, g));
+            _mm_store_si128(reinterpret_cast<__m128i*>(rgb[2]), _mm_packus_epi16(b, b));
+
+            for (uint i = 0; i < 8; ++i) {
+
+                *dst++ = rgb[0][i];
+                *dst++ = rgb[1][i];
+                *dst++ = rgb[2][i];
+            }
         }
+    #endif
+
+    for (uint i = 0; i < count; ++i) {
 
-        else {
+        int r, g, b;
+        YCbCr::to_rgb(y[i], cb[i], cr[i], r, g, b);
 
-            block[i] += 128;
+        *dst++ = r;
+        *dst++ = g;
+        *dst++ = b;
+    }
+}
+
+void transform::ycbcr_to_rgb565(const int* y, const int* cb, const int* cr, uint16_t* dst, uint count) noexcept {
+
+    #ifdef __SSE2__
+        for (; count >= 8; count -= 8, y += 8, cb += 8, cr += 8, dst += 8) {
+
+            __m128i r, g, b;
+            YCbCr::to_rgb_8px(y, cb, cr, r, g, b);
+
+            const __m128i rgb = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_and_si128(r, _mm_set1_epi16(0xf8)), 8),
+                                                          _mm_slli_epi16(_mm_and_si128(g, _mm_set1_epi16(0xfc)), 3)),
+                                             _mm_srli_epi16(b, 3));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), rgb);
         }
+    #endif
+
+    for (uint i = 0; i < count; ++i) {
+
+        int r, g, b;
+        YCbCr::to_rgb(y[i], cb[i], cr[i], r, g, b);
+
+        dst[i] = (r & 0xf8) << 8 | (g & 0xfc) << 3 | b >> 3;
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <sys/types.h>
 
 
 namespace mdjpeg {
@@ -15,7 +16,66 @@ void reverse_zig_zag(int (&block)[64]) noexcept;
 void idct(int (&block)[64]) noexcept;
 
 /// \brief Increments block values by \c +128 and clips results to \c uint8_t range (in place).
-void range_normalize(int (&block)[64]) noexcept;
+///
+/// \note Defined inline so that it can be fused with statically dispatched
+/// BlockWriter implementations (see JpegDecoder::luma_decode).
+inline void range_normalize(int (&block)[64]) noexcept {
+
+    for (uint i = 0; i < 64; ++i) {
+
+        if (block[i] < -128) {
+
+            block[i] = 0;
+        }
+
+        else if (block[i] > 127) {
+
+            block[i] = 255;
+        }
+
+        else {
+
+            block[i] += 128;
+        }
+    }
+}
+
+/// \brief Upsamples the part of a subsampled chroma block covering a single luma block to a whole block.
+///
+/// \param src_block     Chroma block covering all luma blocks of a minimum coded unit.
+/// \param horiz_factor  Horizontal chroma subsampling factor, 1 or 2.
+/// \param vert_factor   Vertical chroma subsampling factor, 1 or 2.
+/// \param col           Column of the luma block within the minimum coded unit, less than \c horiz_factor.
+/// \param row           Row of the luma block within the minimum coded unit, less than \c vert_factor.
+/// \param dst_block     Chroma block covering the single luma block.
+///
+/// Every chroma sample is replicated into `horiz_factor * vert_factor`
+/// adjacent pixels, e.g. 2 for 4:2:2 and 4 for 4:2:0 chroma subsampling.
+void upsample(const int (&src_block)[64], uint8_t horiz_factor, uint8_t vert_factor, uint8_t col, uint8_t row, int (&dst_block)[64]) noexcept;
+
+/// \brief Converts a row of Y'CbCr pixels to 24-bit RGB888 (red first).
+///
+/// \param y      Luma values, in range 0 to 255.
+/// \param cb     Cb values, in range 0 to 255.
+/// \param cr     Cr values, in range 0 to 255.
+/// \param dst    Output, 3 bytes per pixel.
+/// \param count  Count of pixels.
+///
+/// Uses the JFIF conversion with coefficients in 14-bit fixed point and
+/// saturates the results. Vectorized 8 pixels at a time where the target
+/// supports it (SSE2), with identical results.
+void ycbcr_to_rgb888(const int* y, const int* cb, const int* cr, uint8_t* dst, uint count) noexcept;
+
+/// \brief Converts a row of Y'CbCr pixels to 16-bit RGB565 (native byte order).
+///
+/// \param y      Luma values, in range 0 to 255.
+/// \param cb     Cb values, in range 0 to 255.
+/// \param cr     Cr values, in range 0 to 255.
+/// \param dst    Output, 1 value per pixel, red in the most significant bits.
+/// \param count  Count of pixels.
+///
+/// Same as ycbcr_to_rgb888, followed by truncation to 5, 6 and 5 bits.
+void ycbcr_to_rgb565(const int* y, const int* cb, const int* cr, uint16_t* dst, uint count) noexcept;
 
 }  // namespace transform
 